@@ -1,5 +1,6 @@
 #pragma once
 #include <aquarius/mysql/mysql_service.hpp>
+#include <aquarius/mysql/scan.hpp>
 #include <aquarius/mysql/service_pool.hpp>
 #include <aquarius/mysql/sql.hpp>
 
@@ -13,7 +14,7 @@ namespace aquarius
 	template <typename _Ty, string_literal... args>
 	std::vector<_Ty> select(mysql_pool& pool)
 	{
-		return select_chain(pool).select<_Ty, args...>().query();
+		return select_chain(pool).select<_Ty, args...>().query<_Ty, args...>();
 	}
 
 	template <typename _Ty, typename _Func>
@@ -37,6 +38,118 @@ namespace aquarius
 			.async_query<_Ty>(std::forward<_Func>(f));
 	}
 
+	template <typename _Ty, string_literal key>
+	std::vector<_Ty> parallel_select(mysql_pool& pool, scan_mode mode = scan_mode::unordered)
+	{
+		return parallel_scan<mysql_connect, _Ty, key>(pool).query(mode);
+	}
+
+	template <typename _Ty, string_literal key, typename _Func>
+	void parallel_select(mysql_pool& pool, _Func&& f, scan_mode mode = scan_mode::unordered)
+	{
+		parallel_scan<mysql_connect, _Ty, key>(pool).scan(std::forward<_Func>(f), mode);
+	}
+
+	template <typename _Ty, string_literal key, typename _Attr>
+	std::vector<_Ty> parallel_select_if(mysql_pool& pool, _Attr&& attr, scan_mode mode = scan_mode::unordered)
+	{
+		return parallel_scan<mysql_connect, _Ty, key>(pool).where(std::forward<_Attr>(attr)).query(mode);
+	}
+
+	template <typename _Left, typename _Right, typename _On>
+	std::vector<std::tuple<_Left, _Right>> join(mysql_pool& pool, _On&& on)
+	{
+		return select_chain(pool)
+			.join<_Left, _Right>(std::forward<_On>(on))
+			.query_join<std::tuple<_Left, _Right>>();
+	}
+
+	template <typename _Left, typename _Right, typename _On, typename _Attr>
+	std::vector<std::tuple<_Left, _Right>> join_if(mysql_pool& pool, _On&& on, _Attr&& attr)
+	{
+		return select_chain(pool)
+			.join<_Left, _Right>(std::forward<_On>(on))
+			.where(std::forward<_Attr>(attr))
+			.query_join<std::tuple<_Left, _Right>>();
+	}
+
+	template <typename _Left, typename _Right, typename _On>
+	std::vector<std::tuple<_Left, std::optional<_Right>>> left_join(mysql_pool& pool, _On&& on)
+	{
+		return select_chain(pool)
+			.left_join<_Left, _Right>(std::forward<_On>(on))
+			.query_join<std::tuple<_Left, std::optional<_Right>>>();
+	}
+
+	template <typename _Left, typename _Right, typename _On, typename _Attr>
+	std::vector<std::tuple<_Left, std::optional<_Right>>> left_join_if(mysql_pool& pool, _On&& on, _Attr&& attr)
+	{
+		return select_chain(pool)
+			.left_join<_Left, _Right>(std::forward<_On>(on))
+			.where(std::forward<_Attr>(attr))
+			.query_join<std::tuple<_Left, std::optional<_Right>>>();
+	}
+
+	template <typename _Ty>
+	std::uint64_t count(mysql_pool& pool)
+	{
+		return select_chain(pool).count<_Ty>().scalar<std::uint64_t>().value_or(0);
+	}
+
+	template <typename _Ty, typename _Attr>
+	std::uint64_t count_if(mysql_pool& pool, _Attr&& attr)
+	{
+		return select_chain(pool).count<_Ty>().where(std::forward<_Attr>(attr)).scalar<std::uint64_t>().value_or(0);
+	}
+
+	template <typename _Ty>
+	bool exists(mysql_pool& pool)
+	{
+		return select_chain(pool).exists<_Ty>().any();
+	}
+
+	template <typename _Ty, typename _Attr>
+	bool exists_if(mysql_pool& pool, _Attr&& attr)
+	{
+		return select_chain(pool).exists<_Ty>().where(std::forward<_Attr>(attr)).any();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = sum_value_t<_Ty, field>>
+	std::optional<_Result> sum(mysql_pool& pool)
+	{
+		return select_chain(pool).sum<_Ty, field>().scalar<_Result>();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = sum_value_t<_Ty, field>, typename _Attr>
+	std::optional<_Result> sum_if(mysql_pool& pool, _Attr&& attr)
+	{
+		return select_chain(pool).sum<_Ty, field>().where(std::forward<_Attr>(attr)).scalar<_Result>();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = aggregate_value_t<_Ty, field>>
+	std::optional<_Result> min(mysql_pool& pool)
+	{
+		return select_chain(pool).min<_Ty, field>().scalar<_Result>();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = aggregate_value_t<_Ty, field>, typename _Attr>
+	std::optional<_Result> min_if(mysql_pool& pool, _Attr&& attr)
+	{
+		return select_chain(pool).min<_Ty, field>().where(std::forward<_Attr>(attr)).scalar<_Result>();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = aggregate_value_t<_Ty, field>>
+	std::optional<_Result> max(mysql_pool& pool)
+	{
+		return select_chain(pool).max<_Ty, field>().scalar<_Result>();
+	}
+
+	template <typename _Ty, string_literal field, typename _Result = aggregate_value_t<_Ty, field>, typename _Attr>
+	std::optional<_Result> max_if(mysql_pool& pool, _Attr&& attr)
+	{
+		return select_chain(pool).max<_Ty, field>().where(std::forward<_Attr>(attr)).scalar<_Result>();
+	}
+
 	template <typename _Ty>
 	bool insert(mysql_pool& pool, _Ty&& t)
 	{
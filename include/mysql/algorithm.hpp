@@ -1,20 +1,56 @@
 ﻿#pragma once
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
 #include <codecvt>
+#include <cstddef>
+#include <deque>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <boost/mysql.hpp>
 #include <aquarius/mysql/reflect.hpp>
+#include <aquarius/mysql/string_literal.hpp>
 
 #pragma warning(disable : 4996)
 
 namespace aquarius
 {
+	namespace detail
+	{
+		template <typename _Ty>
+		struct is_sys_time : std::false_type
+		{};
+
+		template <typename _Duration>
+		struct is_sys_time<std::chrono::sys_time<_Duration>> : std::true_type
+		{};
+
+		template <typename _Ty>
+		constexpr bool is_sys_time_v = is_sys_time<_Ty>::value;
+
+		template <typename _Ty>
+		constexpr bool is_blob_v = std::same_as<_Ty, std::vector<std::byte>> || std::same_as<_Ty, std::vector<unsigned char>>;
+
+		inline bool iequals(std::string_view lhs, std::string_view rhs)
+		{
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+							  [](char a, char b)
+							  {
+								  return std::tolower(static_cast<unsigned char>(a)) ==
+										 std::tolower(static_cast<unsigned char>(b));
+							  });
+		}
+	} // namespace detail
+
 	template <typename Tuple, typename Func, std::size_t... I>
 	constexpr auto for_each(Tuple&& tuple, Func&& f, std::index_sequence<I...>)
 	{
-		return (std::forward<Func>(f)(aquarius::get<I>(std::forward<Tuple>(tuple))), ...);
+		auto fields = aquarius::tie_fields(tuple);
+
+		return (std::forward<Func>(f)(std::get<I>(fields)), ...);
 	}
 
 	template <typename T, typename Func>
@@ -27,8 +63,9 @@ namespace aquarius
 	template <typename Tuple, typename Func, std::size_t... I>
 	constexpr auto for_each_elem(Tuple&& tuple, Func&& f, std::index_sequence<I...>)
 	{
-		return (std::forward<Func>(f)(name<Tuple, I>(), aquarius::get<I>(std::forward<Tuple>(tuple)), std::move(I)),
-				...);
+		auto fields = aquarius::tie_fields(tuple);
+
+		return (std::forward<Func>(f)(name<Tuple, I>(), std::get<I>(fields), std::move(I)), ...);
 	}
 
 	template <typename T, typename Func>
@@ -99,28 +136,322 @@ namespace aquarius
 	template<typename _Ty>
 	auto cast(const boost::mysql::field_view& field)
 	{
-		std::stringstream ss{};
-		ss << field;
+		using type = std::remove_cvref_t<_Ty>;
+
+		if constexpr (requires { type::from_field(field); })
+		{
+			return type::from_field(field);
+		}
+		else if constexpr (std::same_as<type, std::string>)
+		{
+			if (field.is_string())
+				return type(field.get_string());
+
+			if (field.is_null())
+				return type{};
+
+			std::stringstream ss{};
+			ss << field;
 
+			return ss.str();
+		}
+		else if constexpr (std::is_arithmetic_v<type>)
+		{
+			switch (field.kind())
+			{
+			case boost::mysql::field_kind::int64:
+				return static_cast<type>(field.get_int64());
+			case boost::mysql::field_kind::uint64:
+				return static_cast<type>(field.get_uint64());
+			case boost::mysql::field_kind::float_:
+				return static_cast<type>(field.get_float());
+			case boost::mysql::field_kind::double_:
+				return static_cast<type>(field.get_double());
+			default:
+				break;
+			}
+
+			type result{};
+
+			if constexpr (!std::same_as<type, bool>)
+			{
+				if (field.is_string())
+				{
+					auto str = field.get_string();
+
+					std::from_chars(str.data(), str.data() + str.size(), result);
+				}
+			}
+
+			return result;
+		}
+		else if constexpr (detail::is_sys_time_v<type>)
+		{
+			using duration = typename type::duration;
+
+			if (field.is_datetime() && field.get_datetime().valid())
+				return std::chrono::time_point_cast<duration>(field.get_datetime().as_time_point());
+
+			if (field.is_date() && field.get_date().valid())
+				return std::chrono::time_point_cast<duration>(field.get_date().as_time_point());
+
+			return type{};
+		}
+		else if constexpr (std::same_as<type, boost::mysql::datetime>)
+		{
+			return field.is_datetime() ? field.get_datetime() : type{};
+		}
+		else if constexpr (detail::is_blob_v<type>)
+		{
+			using value_type = typename type::value_type;
+
+			if (field.is_blob())
+			{
+				auto blob = field.get_blob();
+
+				auto begin = reinterpret_cast<const value_type*>(blob.data());
+
+				return type(begin, begin + blob.size());
+			}
+
+			if (field.is_string())
+			{
+				auto str = field.get_string();
+
+				auto begin = reinterpret_cast<const value_type*>(str.data());
+
+				return type(begin, begin + str.size());
+			}
+
+			return type{};
+		}
+		else
+		{
+			std::stringstream ss{};
+			ss << field;
+
+			type result{};
+
+			ss >> result;
+
+			return result;
+		}
+	}
+
+	inline void append_datetime(std::string& sql, std::chrono::sys_time<std::chrono::microseconds> tp)
+	{
+		auto days = std::chrono::floor<std::chrono::days>(tp);
+
+		std::chrono::year_month_day ymd{ days };
+
+		std::chrono::hh_mm_ss<std::chrono::microseconds> hms{ tp - days };
+
+		auto append_number = [&](long long value, int width)
+		{
+			char buf[8]{};
+
+			auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+
+			sql.append(width - std::min<int>(width, static_cast<int>(ptr - buf)), '0');
+			sql.append(buf, ptr);
+		};
+
+		append_number(static_cast<int>(ymd.year()), 4);
+		sql += '-';
+		append_number(static_cast<unsigned>(ymd.month()), 2);
+		sql += '-';
+		append_number(static_cast<unsigned>(ymd.day()), 2);
+		sql += ' ';
+		append_number(hms.hours().count(), 2);
+		sql += ':';
+		append_number(hms.minutes().count(), 2);
+		sql += ':';
+		append_number(hms.seconds().count(), 2);
+		sql += '.';
+		append_number(hms.subseconds().count(), 6);
+	}
+
+	template <typename _Ty>
+	void append_sql_value(std::string& sql, const _Ty& value)
+	{
 		using type = std::remove_cvref_t<_Ty>;
 
-		type result{};
+		if constexpr (std::convertible_to<const type&, std::string_view>)
+		{
+			sql += "'";
+
+			for (auto c : std::string_view(value))
+			{
+				if (c == '\'' || c == '\\')
+					sql += c;
 
-		ss >> result;
+				sql += c;
+			}
 
-		return result;
+			sql += "'";
+		}
+		else if constexpr (std::is_floating_point_v<type>)
+		{
+			char buffer[32]{};
+
+			auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+			sql.append(buffer, end);
+		}
+		else if constexpr (detail::is_sys_time_v<type>)
+		{
+			sql += "'";
+			append_datetime(sql, std::chrono::time_point_cast<std::chrono::microseconds>(value));
+			sql += "'";
+		}
+		else if constexpr (std::same_as<type, boost::mysql::datetime>)
+		{
+			sql += "'";
+			append_datetime(sql, value.as_time_point());
+			sql += "'";
+		}
+		else if constexpr (detail::is_blob_v<type>)
+		{
+			constexpr char hex[] = "0123456789abcdef";
+
+			sql += "X'";
+
+			for (auto byte : value)
+			{
+				auto c = static_cast<unsigned char>(byte);
+
+				sql += hex[c >> 4];
+				sql += hex[c & 0xf];
+			}
+
+			sql += "'";
+		}
+		else if constexpr (requires { value.to_string(); })
+		{
+			sql += value.to_string();
+		}
+		else
+		{
+			sql += std::to_string(value);
+		}
+	}
+
+	template <typename _Ty>
+	boost::mysql::field_view to_field(const _Ty& value, std::deque<std::string>& storage)
+	{
+		using type = std::remove_cvref_t<_Ty>;
+
+		if constexpr (std::convertible_to<const type&, std::string_view>)
+		{
+			return boost::mysql::field_view(std::string_view(storage.emplace_back(std::string_view(value))));
+		}
+		else if constexpr (std::is_integral_v<type> && std::is_signed_v<type>)
+		{
+			return boost::mysql::field_view(static_cast<std::int64_t>(value));
+		}
+		else if constexpr (std::is_integral_v<type>)
+		{
+			return boost::mysql::field_view(static_cast<std::uint64_t>(value));
+		}
+		else if constexpr (std::is_floating_point_v<type>)
+		{
+			return boost::mysql::field_view(static_cast<double>(value));
+		}
+		else if constexpr (detail::is_sys_time_v<type>)
+		{
+			return boost::mysql::field_view(
+				boost::mysql::datetime(std::chrono::time_point_cast<std::chrono::microseconds>(value)));
+		}
+		else if constexpr (std::same_as<type, boost::mysql::datetime>)
+		{
+			return boost::mysql::field_view(value);
+		}
+		else if constexpr (detail::is_blob_v<type>)
+		{
+			auto& bytes = storage.emplace_back(reinterpret_cast<const char*>(value.data()), value.size());
+
+			return boost::mysql::field_view(
+				boost::mysql::blob_view(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()));
+		}
+		else if constexpr (requires { value.to_string(); })
+		{
+			return boost::mysql::field_view(std::string_view(storage.emplace_back(value.to_string())));
+		}
+		else
+		{
+			std::stringstream ss{};
+			ss << value;
+
+			return boost::mysql::field_view(std::string_view(storage.emplace_back(ss.str())));
+		}
+	}
+
+	template <typename T, typename _Row, std::size_t... I>
+	auto to_struct_impl(const _Row& row, std::index_sequence<I...>)
+	{
+		return T{ cast<tuple_element_t<I, T>>(row[I])... };
+	}
+
+	template <typename _Ty, typename _Row>
+	auto cast_column(const _Row& row, std::size_t column)
+	{
+		if (column >= row.size())
+			return std::remove_cvref_t<_Ty>{};
+
+		return cast<_Ty>(row[column]);
+	}
+
+	template <typename T, typename _Row, std::size_t N, std::size_t... I>
+	auto to_struct_impl(const _Row& row, const std::array<std::size_t, N>& index, std::index_sequence<I...>)
+	{
+		return T{ cast_column<tuple_element_t<I, T>>(row, index[I])... };
+	}
+
+	template <typename T, typename _Row, std::size_t N>
+	auto to_struct(const _Row& row, const std::array<std::size_t, N>& index)
+	{
+		return to_struct_impl<T>(row, index, std::make_index_sequence<N>{});
 	}
 
 	template <typename T, std::size_t... I>
-	auto to_struct_impl(const boost::mysql::row& row, std::index_sequence<I...>)
+	constexpr auto identity_index(std::index_sequence<I...>)
 	{
-		return T{ cast<decltype(get<I>(std::declval<T>()))>(row[I])... };
+		return std::array<std::size_t, sizeof...(I)>{ I... };
 	}
 
 	template <typename T>
-	auto to_struct(const boost::mysql::row& row)
+	constexpr auto identity_index()
+	{
+		return identity_index<T>(std::make_index_sequence<tuple_size_v<T>>{});
+	}
+
+	template <typename T, string_literal... args, typename _Row>
+	auto to_projection(const _Row& row)
+	{
+		T result{};
+
+		auto fields = aquarius::tie_fields(result);
+
+		std::size_t column = 0;
+
+		((std::get<field_index<T, args>()>(fields) =
+			  cast<tuple_element_t<field_index<T, args>(), T>>(row[column++])),
+		 ...);
+
+		return result;
+	}
+
+	template <typename T, string_literal... args, typename _Row>
+	auto to_struct(const _Row& row)
 	{
-		return to_struct_impl<T>(row, std::make_index_sequence<tuple_size_v<T>>{});
+		if constexpr (sizeof...(args) == 0)
+		{
+			return to_struct_impl<T>(row, std::make_index_sequence<tuple_size_v<T>>{});
+		}
+		else
+		{
+			return to_projection<T, args...>(row);
+		}
 	}
 
 	template <const std::string_view&... args>
@@ -1,15 +1,24 @@
 #pragma once
 #include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/expression.hpp>
 #include <aquarius/mysql/keyword.hpp>
 #include <aquarius/mysql/string_literal.hpp>
 #include <aquarius/type_traits.hpp>
+#include <ranges>
 
 namespace aquarius
 {
+	template <typename _Ty>
+	concept value_range_t =
+		std::ranges::range<std::remove_cvref_t<_Ty>> && !std::convertible_to<_Ty, std::string_view>;
+
 	template <string_literal sl>
-	class attributes
+	class attributes : public expression<attributes<sl>>
 	{
-		static constexpr std::string_view sql_begin = concat_v<SPACE, bind_param<sl>::value>;
+		static constexpr std::string_view column_name = bind_param<sl>::value;
+
+	public:
+		static constexpr int precedence = 0;
 
 	public:
 		attributes() = default;
@@ -18,111 +27,98 @@ namespace aquarius
 
 	public:
 		template <typename _Ty>
-		attributes& operator==(_Ty&& t)
+		auto operator==(_Ty&& t) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, EQUAL, SPACE>;
-
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
-
-			return *this;
+			return compare<EQUAL>(std::forward<_Ty>(t));
 		}
 
 		template <typename _Ty>
-		attributes& operator!=(_Ty&& t)
+		auto operator!=(_Ty&& t) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, NOT, EQUAL, SPACE>;
-
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
-
-			return *this;
+			return compare<NOT_EQUAL>(std::forward<_Ty>(t));
 		}
 
 		template <typename _Ty>
-		attributes& operator<(_Ty&& t)
+		auto operator<(_Ty&& t) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, LESS, SPACE>;
-
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
-
-			return *this;
+			return compare<LESS>(std::forward<_Ty>(t));
 		}
 
 		template <typename _Ty>
-		attributes& operator<=(_Ty&& t)
+		auto operator<=(_Ty&& t) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, LESS, EQUAL, SPACE>;
-
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
-
-			return *this;
+			return compare<LESS_EQUAL>(std::forward<_Ty>(t));
 		}
 
 		template <typename _Ty>
-		attributes& operator>(_Ty&& t)
+		auto operator>(_Ty&& t) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, GREATER, SPACE>;
-
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
+			return compare<GREATER>(std::forward<_Ty>(t));
+		}
 
-			return *this;
+		template <typename _Ty>
+		auto operator>=(_Ty&& t) const
+		{
+			return compare<GREATER_EQUAL>(std::forward<_Ty>(t));
 		}
 
 		template <typename _Ty>
-		attributes& operator>=(_Ty&& t)
+		auto like(_Ty&& pattern) const
 		{
-			constexpr auto sql = concat_v<sql_begin, SPACE, GREATER, EQUAL, SPACE>;
+			return compare<LIKE>(std::forward<_Ty>(pattern));
+		}
 
-			attr_str_ += sql;
-			add_value(std::forward<_Ty>(t));
+		template <typename _Low, typename _High>
+		auto between(_Low&& low, _High&& high) const
+		{
+			return between_expr<attributes, operand_t<_Low>, operand_t<_High>>(
+				*this, make_operand(std::forward<_Low>(low)), make_operand(std::forward<_High>(high)));
+		}
 
-			return *this;
+		template <typename _Ty, typename... _Args>
+		requires(sizeof...(_Args) != 0 || !value_range_t<_Ty>)
+		auto in(_Ty&& t, _Args&&... args) const
+		{
+			return in_expr<attributes, operand_t<_Ty>, operand_t<_Args>...>(
+				*this, make_operand(std::forward<_Ty>(t)), make_operand(std::forward<_Args>(args))...);
 		}
 
-		attributes& operator|(const attributes& other)
+		template <value_range_t _Range>
+		auto in(_Range&& range) const
 		{
-			attr_str_ += concat_v<SPACE, OR>;
-			attr_str_ += other.attr_str_;
+			using range_type = std::conditional_t<std::is_lvalue_reference_v<_Range>, const std::remove_cvref_t<_Range>&,
+												  std::remove_cvref_t<_Range>>;
 
-			return *this;
+			return in_range_expr<attributes, range_type>(*this, std::forward<_Range>(range));
 		}
 
-		attributes& operator&(const attributes& other)
+		auto is_null() const
 		{
-			attr_str_ += concat_v<SPACE, AND>;
-
-			attr_str_ += other.attr_str_;
+			return postfix_expr<attributes, IS_NULL>(*this);
+		}
 
-			return *this;
+		auto is_not_null() const
+		{
+			return postfix_expr<attributes, IS_NOT_NULL>(*this);
 		}
 
-		std::string sql()
+		template <typename _Out>
+		void render(_Out& out) const
 		{
-			return attr_str_;
+			out.sql += column_name;
 		}
 
-	private:
-		template <typename _Ty>
-		void add_value(_Ty&& t)
+		std::size_t size_hint() const
 		{
-			if constexpr (detail::is_string_v<_Ty>)
-			{
-				attr_str_.append("'");
-				attr_str_.append(t);
-				attr_str_.append("'");
-			}
-			else
-			{
-				attr_str_ += std::to_string(t);
-			}
+			return column_name.size();
 		}
 
 	private:
-		std::string attr_str_;
+		template <const std::string_view& _Op, typename _Ty>
+		auto compare(_Ty&& t) const
+		{
+			return compare_expr<attributes, operand_t<_Ty>, _Op>(*this, make_operand(std::forward<_Ty>(t)));
+		}
 	};
 } // namespace aquarius
 
@@ -0,0 +1,437 @@
+#pragma once
+#include <aquarius/logger.hpp>
+#include <aquarius/mysql/digest.hpp>
+#include <aquarius/mysql/metrics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	struct capture_options
+	{
+		std::string path = "workload.capture";
+
+		std::size_t buffer_bytes = 64 * 1024;
+	};
+
+	struct capture_record
+	{
+		std::uint64_t time_ns = 0;
+
+		std::uint64_t connection_id = 0;
+
+		std::uint64_t latency_ns = 0;
+
+		std::uint64_t rows = 0;
+
+		bool failed = false;
+
+		std::string sql;
+	};
+
+	namespace detail
+	{
+		inline constexpr std::string_view capture_magic = "AQWC";
+
+		inline constexpr char capture_version = 1;
+
+		inline void put_varint(std::string& out, std::uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				out += static_cast<char>((value & 0x7f) | 0x80);
+
+				value >>= 7;
+			}
+
+			out += static_cast<char>(value);
+		}
+
+		inline bool get_varint(std::istream& in, std::uint64_t& value)
+		{
+			value = 0;
+
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				auto c = in.get();
+
+				if (c == std::char_traits<char>::eof())
+					return false;
+
+				value |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+
+				if ((c & 0x80) == 0)
+					return true;
+			}
+
+			return false;
+		}
+
+		inline std::uint64_t zigzag(std::int64_t value)
+		{
+			return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+		}
+
+		inline std::int64_t unzigzag(std::uint64_t value)
+		{
+			return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+		}
+	} // namespace detail
+
+	class capture_writer
+	{
+	public:
+		explicit capture_writer(capture_options options)
+			: options_(std::move(options))
+			, stream_(options_.path, std::ios::binary | std::ios::trunc)
+		{
+			buffer_.append(detail::capture_magic);
+
+			buffer_ += detail::capture_version;
+		}
+
+		~capture_writer()
+		{
+			flush();
+		}
+
+	public:
+		explicit operator bool() const
+		{
+			return static_cast<bool>(stream_);
+		}
+
+		void write(const capture_record& record)
+		{
+			std::lock_guard lk(mutex_);
+
+			detail::put_varint(buffer_, detail::zigzag(static_cast<std::int64_t>(record.time_ns - last_time_)));
+			detail::put_varint(buffer_, record.connection_id);
+			detail::put_varint(buffer_, record.latency_ns);
+			detail::put_varint(buffer_, record.rows);
+			detail::put_varint(buffer_, record.failed ? 1 : 0);
+			detail::put_varint(buffer_, record.sql.size());
+
+			buffer_.append(record.sql);
+
+			last_time_ = record.time_ns;
+
+			if (buffer_.size() >= options_.buffer_bytes)
+				write_buffer();
+		}
+
+		void flush()
+		{
+			std::lock_guard lk(mutex_);
+
+			write_buffer();
+
+			stream_.flush();
+		}
+
+	private:
+		void write_buffer()
+		{
+			stream_.write(buffer_.data(), buffer_.size());
+
+			buffer_.clear();
+		}
+
+	private:
+		capture_options options_;
+
+		std::mutex mutex_;
+
+		std::ofstream stream_;
+
+		std::string buffer_;
+
+		std::uint64_t last_time_ = 0;
+	};
+
+	class capture_reader
+	{
+	public:
+		explicit capture_reader(const std::filesystem::path& path)
+			: stream_(path, std::ios::binary)
+		{
+			char header[5]{};
+
+			stream_.read(header, sizeof(header));
+
+			valid_ = stream_ && std::string_view(header, 4) == detail::capture_magic &&
+					 header[4] == detail::capture_version;
+		}
+
+	public:
+		explicit operator bool() const
+		{
+			return valid_;
+		}
+
+		bool next(capture_record& record)
+		{
+			if (!valid_)
+				return false;
+
+			std::uint64_t delta = 0;
+
+			std::uint64_t failed = 0;
+
+			std::uint64_t size = 0;
+
+			if (!detail::get_varint(stream_, delta))
+				return false;
+
+			if (!detail::get_varint(stream_, record.connection_id) || !detail::get_varint(stream_, record.latency_ns) ||
+				!detail::get_varint(stream_, record.rows) || !detail::get_varint(stream_, failed) ||
+				!detail::get_varint(stream_, size))
+			{
+				valid_ = false;
+
+				return false;
+			}
+
+			record.sql.resize(static_cast<std::size_t>(size));
+
+			if (!stream_.read(record.sql.data(), static_cast<std::streamsize>(size)))
+			{
+				valid_ = false;
+
+				return false;
+			}
+
+			last_time_ += static_cast<std::uint64_t>(detail::unzigzag(delta));
+
+			record.time_ns = last_time_;
+			record.failed = failed != 0;
+
+			return true;
+		}
+
+	private:
+		std::ifstream stream_;
+
+		bool valid_ = false;
+
+		std::uint64_t last_time_ = 0;
+	};
+
+	enum class replay_mode
+	{
+		original,
+		scaled,
+		fast
+	};
+
+	struct replay_options
+	{
+		replay_mode mode = replay_mode::original;
+
+		double speed = 1.0;
+	};
+
+	struct replay_statement
+	{
+		std::uint64_t digest = 0;
+
+		std::string text;
+
+		std::uint64_t calls = 0;
+
+		std::uint64_t errors = 0;
+
+		histogram_snapshot original;
+
+		histogram_snapshot replayed;
+	};
+
+	struct replay_report
+	{
+		std::uint64_t statements = 0;
+
+		std::uint64_t errors = 0;
+
+		std::uint64_t sessions = 0;
+
+		std::uint64_t captured_ns = 0;
+
+		std::uint64_t elapsed_ns = 0;
+
+		histogram_snapshot original;
+
+		histogram_snapshot replayed;
+
+		std::vector<replay_statement> digests;
+	};
+
+	namespace detail
+	{
+		struct replay_digest
+		{
+			explicit replay_digest(std::string fingerprint_text)
+				: text(std::move(fingerprint_text))
+			{}
+
+			std::string text;
+
+			std::atomic<std::uint64_t> errors{ 0 };
+
+			latency_histogram original;
+
+			latency_histogram replayed;
+		};
+
+		struct replay_item
+		{
+			capture_record record;
+
+			replay_digest* digest = nullptr;
+		};
+	} // namespace detail
+
+	template <typename _Pool>
+	replay_report replay(_Pool& pool, const std::filesystem::path& path, replay_options options = {})
+	{
+		replay_report report{};
+
+		capture_reader reader(path);
+
+		if (!reader)
+		{
+			XLOG_ERROR() << "capture: " << path.string() << " open failed!";
+
+			return report;
+		}
+
+		std::unordered_map<std::uint64_t, std::unique_ptr<detail::replay_digest>> digests{};
+
+		std::map<std::uint64_t, std::vector<detail::replay_item>> sessions{};
+
+		latency_histogram original{};
+
+		latency_histogram replayed{};
+
+		std::uint64_t first = std::numeric_limits<std::uint64_t>::max();
+
+		std::uint64_t last = 0;
+
+		detail::replay_item item{};
+
+		while (reader.next(item.record))
+		{
+			auto text = fingerprint(item.record.sql);
+
+			auto& digest = digests[digest_hash(text)];
+
+			if (!digest)
+				digest = std::make_unique<detail::replay_digest>(std::move(text));
+
+			digest->original.record(item.record.latency_ns);
+
+			original.record(item.record.latency_ns);
+
+			item.digest = digest.get();
+
+			first = std::min(first, item.record.time_ns);
+
+			last = std::max(last, item.record.time_ns);
+
+			sessions[item.record.connection_id].push_back(std::move(item));
+
+			item = {};
+		}
+
+		if (sessions.empty())
+			return report;
+
+		auto speed = options.mode == replay_mode::scaled && options.speed > 0 ? options.speed : 1.0;
+
+		std::atomic<std::uint64_t> errors{ 0 };
+
+		std::vector<std::thread> workers{};
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (auto& [connection_id, items] : sessions)
+		{
+			std::stable_sort(items.begin(), items.end(),
+							 [](const auto& lhs, const auto& rhs) { return lhs.record.time_ns < rhs.record.time_ns; });
+
+			workers.emplace_back(
+				[&, &items = items]
+				{
+					for (auto& value : items)
+					{
+						if (options.mode != replay_mode::fast)
+						{
+							auto offset = static_cast<double>(value.record.time_ns - first) / speed;
+
+							std::this_thread::sleep_until(start +
+														  std::chrono::nanoseconds(static_cast<std::int64_t>(offset)));
+						}
+
+						auto begin = std::chrono::steady_clock::now();
+
+						auto res = pool.query_rows(value.record.sql, [](const auto&, const auto&) {});
+
+						auto latency = elapsed_ns(begin);
+
+						value.digest->replayed.record(latency);
+
+						replayed.record(latency);
+
+						if (!res)
+						{
+							value.digest->errors.fetch_add(1, std::memory_order_relaxed);
+
+							errors.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				});
+		}
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		report.statements = original.count();
+		report.errors = errors.load(std::memory_order_relaxed);
+		report.sessions = sessions.size();
+		report.captured_ns = last - first;
+		report.elapsed_ns = elapsed_ns(start);
+		report.original = original.snapshot({});
+		report.replayed = replayed.snapshot({});
+
+		for (auto& [digest, value] : digests)
+		{
+			auto& statement = report.digests.emplace_back();
+
+			statement.digest = digest;
+			statement.text = value->text;
+			statement.errors = value->errors.load(std::memory_order_relaxed);
+			statement.original = value->original.snapshot({});
+			statement.replayed = value->replayed.snapshot({});
+			statement.calls = statement.original.count;
+		}
+
+		std::sort(report.digests.begin(), report.digests.end(),
+				  [](const auto& lhs, const auto& rhs) { return lhs.replayed.sum > rhs.replayed.sum; });
+
+		return report;
+	}
+} // namespace aquarius
@@ -0,0 +1,152 @@
+#pragma once
+#include <aquarius/logger.hpp>
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/reflect.hpp>
+#include <boost/mysql.hpp>
+#include <array>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	inline constexpr std::size_t npos_column = std::numeric_limits<std::size_t>::max();
+
+	template <named_fields_t _Ty>
+	class column_map
+	{
+		static constexpr std::size_t field_count = tuple_size_v<_Ty>;
+
+	public:
+		using index_type = std::array<std::size_t, field_count>;
+
+	private:
+		struct shape
+		{
+			std::vector<std::string> columns;
+
+			index_type index;
+		};
+
+	public:
+		template <typename _Meta>
+		static index_type get(const _Meta& meta)
+		{
+			const auto key = hash(meta);
+
+			{
+				std::shared_lock lk(mutex());
+
+				if (auto index = find(key, meta))
+					return *index;
+			}
+
+			auto new_shape = make_shape(meta);
+
+			std::unique_lock lk(mutex());
+
+			if (auto index = find(key, meta))
+				return *index;
+
+			shapes().emplace(key, new_shape);
+
+			return new_shape->index;
+		}
+
+	private:
+		template <typename _Meta>
+		static const index_type* find(std::size_t key, const _Meta& meta)
+		{
+			auto [begin, end] = shapes().equal_range(key);
+
+			for (auto iter = begin; iter != end; ++iter)
+			{
+				if (same_columns(iter->second->columns, meta))
+					return &iter->second->index;
+			}
+
+			return nullptr;
+		}
+
+		template <typename _Meta>
+		static std::shared_ptr<shape> make_shape(const _Meta& meta)
+		{
+			constexpr auto names = field_names<_Ty>();
+
+			auto result = std::make_shared<shape>();
+
+			result->index.fill(npos_column);
+
+			for (std::size_t column = 0; column < meta.size(); ++column)
+			{
+				auto column_name = meta[column].column_name();
+
+				result->columns.emplace_back(column_name);
+
+				for (std::size_t field = 0; field < names.size(); ++field)
+				{
+					if (result->index[field] == npos_column && detail::iequals(names[field], column_name))
+					{
+						result->index[field] = column;
+						break;
+					}
+				}
+			}
+
+			for (std::size_t field = 0; field < names.size(); ++field)
+			{
+				if (result->index[field] == npos_column)
+					XLOG_ERROR() << "column_map: " << name<_Ty>() << "." << names[field] << " has no column in the result!";
+			}
+
+			return result;
+		}
+
+		template <typename _Meta>
+		static std::size_t hash(const _Meta& meta)
+		{
+			std::size_t seed = meta.size();
+
+			for (auto& column : meta)
+			{
+				seed ^= std::hash<std::string_view>{}(column.column_name()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+
+			return seed;
+		}
+
+		template <typename _Meta>
+		static bool same_columns(const std::vector<std::string>& columns, const _Meta& meta)
+		{
+			if (columns.size() != meta.size())
+				return false;
+
+			for (std::size_t i = 0; i < columns.size(); ++i)
+			{
+				if (columns[i] != meta[i].column_name())
+					return false;
+			}
+
+			return true;
+		}
+
+		static std::shared_mutex& mutex()
+		{
+			static std::shared_mutex shape_mutex{};
+
+			return shape_mutex;
+		}
+
+		static std::unordered_multimap<std::size_t, std::shared_ptr<shape>>& shapes()
+		{
+			static std::unordered_multimap<std::size_t, std::shared_ptr<shape>> shape_cache{};
+
+			return shape_cache;
+		}
+	};
+} // namespace aquarius
@@ -0,0 +1,162 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <boost/mysql.hpp>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace aquarius
+{
+	template <typename _Ty>
+	struct column_value
+	{
+		using type = std::remove_cvref_t<_Ty>;
+	};
+
+	template <>
+	struct column_value<bool>
+	{
+		using type = std::uint8_t;
+	};
+
+	template <typename _Ty>
+	using column_value_t = typename column_value<std::remove_cvref_t<_Ty>>::type;
+
+	template <typename _Ty>
+	class column_result
+	{
+		static constexpr std::size_t field_count = tuple_size_v<_Ty>;
+
+		template <std::size_t... I>
+		static auto make_columns(std::index_sequence<I...>)
+			-> std::tuple<std::vector<column_value_t<tuple_element_t<I, _Ty>>>...>;
+
+		using columns_type = decltype(make_columns(std::make_index_sequence<field_count>{}));
+
+		using bitmap_type = std::vector<std::uint64_t>;
+
+	public:
+		column_result() = default;
+
+		~column_result() = default;
+
+	public:
+		std::size_t size() const
+		{
+			return rows_;
+		}
+
+		bool empty() const
+		{
+			return rows_ == 0;
+		}
+
+		template <std::size_t I>
+		const auto& column() const
+		{
+			return std::get<I>(columns_);
+		}
+
+		template <string_literal field>
+		const auto& column() const
+		{
+			return column<field_index<_Ty, field>()>();
+		}
+
+		template <std::size_t I>
+		const bitmap_type& null_bitmap() const
+		{
+			return null_bitmaps_[I];
+		}
+
+		template <std::size_t I>
+		bool is_null(std::size_t row) const
+		{
+			return (null_bitmaps_[I][row / 64] >> (row % 64)) & 1;
+		}
+
+		void reserve(std::size_t rows)
+		{
+			reserve(rows, std::make_index_sequence<field_count>{});
+
+			for (auto& bitmap : null_bitmaps_)
+			{
+				bitmap.reserve((rows + 63) / 64);
+			}
+		}
+
+		template <typename _Row>
+		void push_back(const _Row& row, const std::array<std::size_t, field_count>& index)
+		{
+			if (rows_ % 64 == 0)
+			{
+				for (auto& bitmap : null_bitmaps_)
+				{
+					bitmap.push_back(0);
+				}
+			}
+
+			push_back(row, index, std::make_index_sequence<field_count>{});
+
+			++rows_;
+		}
+
+	private:
+		template <std::size_t... I>
+		void reserve(std::size_t rows, std::index_sequence<I...>)
+		{
+			(std::get<I>(columns_).reserve(rows), ...);
+		}
+
+		template <typename _Row, std::size_t... I>
+		void push_back(const _Row& row, const std::array<std::size_t, field_count>& index, std::index_sequence<I...>)
+		{
+			(push_field<I>(row, index[I]), ...);
+		}
+
+		template <std::size_t I, typename _Row>
+		void push_field(const _Row& row, std::size_t column)
+		{
+			using type = column_value_t<tuple_element_t<I, _Ty>>;
+
+			if (column >= row.size() || row[column].is_null())
+			{
+				null_bitmaps_[I].back() |= std::uint64_t(1) << (rows_ % 64);
+
+				std::get<I>(columns_).push_back(type{});
+
+				return;
+			}
+
+			std::get<I>(columns_).push_back(static_cast<type>(cast<tuple_element_t<I, _Ty>>(row[column])));
+		}
+
+	private:
+		columns_type columns_;
+
+		std::array<bitmap_type, field_count> null_bitmaps_;
+
+		std::size_t rows_ = 0;
+	};
+
+	template <typename _Ty, typename _Rows, std::size_t N>
+	column_result<_Ty> make_column_result(const _Rows& rows, const std::array<std::size_t, N>& index)
+	{
+		column_result<_Ty> result{};
+
+		result.reserve(rows.size());
+
+		for (const auto& row : rows)
+		{
+			result.push_back(row, index);
+		}
+
+		return result;
+	}
+
+	template <typename _Ty, typename _Rows>
+	column_result<_Ty> make_column_result(const _Rows& rows)
+	{
+		return make_column_result<_Ty>(rows, identity_index<_Ty>());
+	}
+} // namespace aquarius
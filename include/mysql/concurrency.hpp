@@ -0,0 +1,208 @@
+#pragma once
+#include <boost/mysql.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+
+namespace aquarius
+{
+	enum class pool_errc
+	{
+		overloaded = 65536
+	};
+
+	class pool_error_category : public boost::system::error_category
+	{
+	public:
+		const char* name() const noexcept override
+		{
+			return "aquarius.pool";
+		}
+
+		std::string message(int value) const override
+		{
+			switch (static_cast<pool_errc>(value))
+			{
+			case pool_errc::overloaded:
+				return "too many operations in flight";
+			}
+
+			return "unknown pool error";
+		}
+
+	public:
+		static const pool_error_category& get()
+		{
+			static const pool_error_category category{};
+
+			return category;
+		}
+	};
+
+	inline boost::system::error_code make_error_code(pool_errc value)
+	{
+		return { static_cast<int>(value), pool_error_category::get() };
+	}
+
+	struct concurrency_options
+	{
+		std::size_t initial_limit = 20;
+
+		std::size_t min_limit = 1;
+
+		std::size_t max_limit = 1000;
+
+		std::size_t probe_interval = 1000;
+
+		double smoothing = 1.0;
+	};
+
+	class concurrency_limiter
+	{
+	public:
+		explicit concurrency_limiter(concurrency_options options = {})
+			: options_(options)
+			, estimate_(static_cast<double>(options.initial_limit))
+			, limit_(options.initial_limit)
+		{}
+
+	public:
+		bool try_acquire()
+		{
+			auto current = inflight_.load(std::memory_order_relaxed);
+
+			do
+			{
+				if (current >= limit_.load(std::memory_order_relaxed))
+				{
+					rejected_.fetch_add(1, std::memory_order_relaxed);
+
+					return false;
+				}
+			} while (!inflight_.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel,
+													  std::memory_order_relaxed));
+
+			return true;
+		}
+
+		void release(std::uint64_t latency_ns)
+		{
+			auto inflight = inflight_.fetch_sub(1, std::memory_order_acq_rel);
+
+			update(latency_ns, inflight);
+		}
+
+		std::size_t limit() const
+		{
+			return limit_.load(std::memory_order_relaxed);
+		}
+
+		std::size_t inflight() const
+		{
+			return inflight_.load(std::memory_order_relaxed);
+		}
+
+		std::uint64_t rejected() const
+		{
+			return rejected_.load(std::memory_order_relaxed);
+		}
+
+	private:
+		void update(std::uint64_t latency_ns, std::size_t inflight)
+		{
+			if (latency_ns == 0)
+				return;
+
+			std::lock_guard lk(mutex_);
+
+			if (probe_samples_ != 0)
+			{
+				if (inflight > limit_.load(std::memory_order_relaxed))
+					return;
+
+				probe_min_ = std::min(probe_min_, latency_ns);
+
+				if (--probe_samples_ != 0)
+					return;
+
+				no_load_ = probe_min_;
+
+				limit_.store(static_cast<std::size_t>(estimate_), std::memory_order_relaxed);
+
+				return;
+			}
+
+			if (++samples_ >= options_.probe_interval)
+			{
+				samples_ = 0;
+
+				auto probe_limit = std::max(options_.min_limit, static_cast<std::size_t>(estimate_ / 2));
+
+				probe_samples_ = probe_limit;
+
+				probe_min_ = std::numeric_limits<std::uint64_t>::max();
+
+				limit_.store(probe_limit, std::memory_order_relaxed);
+
+				return;
+			}
+
+			if (no_load_ == 0 || latency_ns < no_load_)
+			{
+				no_load_ = latency_ns;
+
+				return;
+			}
+
+			if (static_cast<double>(inflight) * 2 < estimate_)
+				return;
+
+			auto step = std::max(1.0, std::log10(estimate_));
+
+			auto queue = std::ceil(estimate_ * (1.0 - static_cast<double>(no_load_) / static_cast<double>(latency_ns)));
+
+			auto next = estimate_;
+
+			if (queue <= step)
+				next += 6 * step;
+			else if (queue < 3 * step)
+				next += step;
+			else if (queue > 6 * step)
+				next -= step;
+			else
+				return;
+
+			next = std::clamp(next, static_cast<double>(options_.min_limit), static_cast<double>(options_.max_limit));
+
+			estimate_ = (1.0 - options_.smoothing) * estimate_ + options_.smoothing * next;
+
+			limit_.store(static_cast<std::size_t>(estimate_), std::memory_order_relaxed);
+		}
+
+	private:
+		concurrency_options options_;
+
+		std::mutex mutex_;
+
+		double estimate_;
+
+		std::uint64_t no_load_ = 0;
+
+		std::size_t samples_ = 0;
+
+		std::size_t probe_samples_ = 0;
+
+		std::uint64_t probe_min_ = 0;
+
+		std::atomic<std::size_t> limit_;
+
+		std::atomic<std::size_t> inflight_{ 0 };
+
+		std::atomic<std::uint64_t> rejected_{ 0 };
+	};
+} // namespace aquarius
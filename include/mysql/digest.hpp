@@ -0,0 +1,357 @@
+#pragma once
+#include <aquarius/mysql/metrics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	namespace detail
+	{
+		inline bool is_identifier_char(char c)
+		{
+			return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+		}
+
+		inline void append_placeholder(std::string& text)
+		{
+			auto end = text.find_last_not_of(' ');
+
+			if (end != std::string::npos && text[end] == '(')
+			{
+				text += "...";
+
+				return;
+			}
+
+			if (end != std::string::npos && end != 0 && text[end] == ',')
+			{
+				auto prev = text.find_last_not_of(' ', end - 1);
+
+				if (prev != std::string::npos && text[prev] == '?')
+				{
+					text.resize(prev);
+					text += "...";
+
+					return;
+				}
+
+				if (prev != std::string::npos && prev >= 2 && text.compare(prev - 2, 3, "...") == 0)
+				{
+					text.resize(prev + 1);
+
+					return;
+				}
+			}
+
+			text += '?';
+		}
+
+		inline bool is_unary_minus(std::string_view sql, std::size_t pos, const std::string& text)
+		{
+			if (sql[pos] != '-' || pos + 1 >= sql.size() || !std::isdigit(static_cast<unsigned char>(sql[pos + 1])))
+				return false;
+
+			auto end = text.find_last_not_of(' ');
+
+			if (end == std::string::npos)
+				return true;
+
+			auto c = text[end];
+
+			return !is_identifier_char(c) && c != ')' && c != '?' && c != '.' && c != '`' && c != '\'' && c != '"';
+		}
+
+		inline std::size_t skip_quoted(std::string_view sql, std::size_t pos)
+		{
+			auto quote = sql[pos++];
+
+			while (pos < sql.size())
+			{
+				if (sql[pos] == '\\')
+				{
+					pos += 2;
+					continue;
+				}
+
+				if (sql[pos] == quote)
+				{
+					if (pos + 1 < sql.size() && sql[pos + 1] == quote)
+					{
+						pos += 2;
+						continue;
+					}
+
+					return pos + 1;
+				}
+
+				++pos;
+			}
+
+			return pos;
+		}
+	} // namespace detail
+
+	inline void fingerprint(std::string_view sql, std::string& text)
+	{
+		text.clear();
+
+		std::size_t pos = 0;
+
+		while (pos < sql.size())
+		{
+			auto c = sql[pos];
+
+			if (std::isspace(static_cast<unsigned char>(c)))
+			{
+				while (pos < sql.size() && std::isspace(static_cast<unsigned char>(sql[pos])))
+				{
+					++pos;
+				}
+
+				if (!text.empty())
+					text += ' ';
+
+				continue;
+			}
+
+			bool word_start = text.empty() || !detail::is_identifier_char(text.back());
+
+			if (c == '\'' || c == '"')
+			{
+				pos = detail::skip_quoted(sql, pos);
+
+				detail::append_placeholder(text);
+
+				continue;
+			}
+
+			if ((c == 'x' || c == 'X' || c == 'b' || c == 'B') && word_start && pos + 1 < sql.size() &&
+				sql[pos + 1] == '\'')
+			{
+				pos = detail::skip_quoted(sql, pos + 1);
+
+				detail::append_placeholder(text);
+
+				continue;
+			}
+
+			if (detail::is_unary_minus(sql, pos, text))
+			{
+				++pos;
+
+				c = sql[pos];
+			}
+
+			if (std::isdigit(static_cast<unsigned char>(c)) && word_start)
+			{
+				while (pos < sql.size() && (detail::is_identifier_char(sql[pos]) || sql[pos] == '.'))
+				{
+					++pos;
+				}
+
+				detail::append_placeholder(text);
+
+				continue;
+			}
+
+			if (c == '`')
+			{
+				auto end = sql.find('`', pos + 1);
+
+				end = end == std::string_view::npos ? sql.size() : end + 1;
+
+				text.append(sql.substr(pos, end - pos));
+
+				pos = end;
+
+				continue;
+			}
+
+			text += c;
+
+			++pos;
+		}
+
+		while (!text.empty() && (text.back() == ' ' || text.back() == ';'))
+		{
+			text.pop_back();
+		}
+	}
+
+	inline std::string fingerprint(std::string_view sql)
+	{
+		std::string text{};
+
+		fingerprint(sql, text);
+
+		return text;
+	}
+
+	inline std::uint64_t digest_hash(std::string_view text)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+
+		for (auto c : text)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	struct digest_snapshot
+	{
+		std::uint64_t digest = 0;
+
+		std::string text;
+
+		std::uint64_t calls = 0;
+
+		std::uint64_t errors = 0;
+
+		std::uint64_t rows = 0;
+
+		std::uint64_t bytes = 0;
+
+		std::uint64_t total_latency = 0;
+
+		std::uint64_t p50 = 0;
+
+		std::uint64_t p99 = 0;
+
+		std::uint64_t max = 0;
+	};
+
+	class digest_table
+	{
+		struct entry
+		{
+			explicit entry(std::string_view fingerprint_text)
+				: text(fingerprint_text)
+			{}
+
+			std::string text;
+
+			std::atomic<std::uint64_t> errors{ 0 };
+
+			std::atomic<std::uint64_t> rows{ 0 };
+
+			std::atomic<std::uint64_t> bytes{ 0 };
+
+			latency_histogram latency;
+		};
+
+	public:
+		explicit digest_table(std::size_t capacity = 1024)
+			: capacity_(capacity)
+		{}
+
+		~digest_table() = default;
+
+	public:
+		void record(std::string_view sql, std::uint64_t latency_ns, bool failed, std::uint64_t rows,
+					std::uint64_t bytes)
+		{
+			thread_local std::string text{};
+
+			fingerprint(sql, text);
+
+			auto item = find(text);
+
+			item->latency.record(latency_ns);
+
+			if (failed)
+				item->errors.fetch_add(1, std::memory_order_relaxed);
+
+			item->rows.fetch_add(rows, std::memory_order_relaxed);
+
+			item->bytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		std::vector<digest_snapshot> snapshot() const
+		{
+			std::vector<digest_snapshot> result{};
+
+			std::shared_lock lk(mutex_);
+
+			result.reserve(entries_.size());
+
+			for (auto& [digest, item] : entries_)
+			{
+				auto latency = item->latency.snapshot({});
+
+				auto& value = result.emplace_back();
+
+				value.digest = digest;
+				value.text = item->text;
+				value.calls = latency.count;
+				value.errors = item->errors.load(std::memory_order_relaxed);
+				value.rows = item->rows.load(std::memory_order_relaxed);
+				value.bytes = item->bytes.load(std::memory_order_relaxed);
+				value.total_latency = latency.sum;
+				value.p50 = latency.p50;
+				value.p99 = latency.p99;
+				value.max = latency.max;
+			}
+
+			std::sort(result.begin(), result.end(),
+					  [](const auto& lhs, const auto& rhs) { return lhs.total_latency > rhs.total_latency; });
+
+			return result;
+		}
+
+		void reset()
+		{
+			std::unique_lock lk(mutex_);
+
+			entries_.clear();
+		}
+
+	private:
+		std::shared_ptr<entry> find(std::string_view text)
+		{
+			auto digest = digest_hash(text);
+
+			{
+				std::shared_lock lk(mutex_);
+
+				auto iter = entries_.find(digest);
+
+				if (iter != entries_.end())
+					return iter->second;
+			}
+
+			std::unique_lock lk(mutex_);
+
+			if (entries_.size() >= capacity_ && !entries_.contains(digest))
+			{
+				digest = 0;
+				text = "<other>";
+			}
+
+			auto iter = entries_.find(digest);
+
+			if (iter == entries_.end())
+				iter = entries_.emplace(digest, std::make_shared<entry>(text)).first;
+
+			return iter->second;
+		}
+
+	private:
+		std::size_t capacity_;
+
+		mutable std::shared_mutex mutex_;
+
+		std::unordered_map<std::uint64_t, std::shared_ptr<entry>> entries_;
+	};
+} // namespace aquarius
@@ -0,0 +1,517 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/keyword.hpp>
+#include <boost/mysql.hpp>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace aquarius
+{
+	template <typename _Ty>
+	concept expression_t = requires { std::remove_cvref_t<_Ty>::precedence; };
+
+	template <typename _Ty>
+	using expression_value_t =
+		std::conditional_t<std::convertible_to<_Ty, std::string_view> &&
+							   (std::is_lvalue_reference_v<_Ty> || std::is_pointer_v<std::decay_t<_Ty>>),
+						   std::string_view, std::remove_cvref_t<_Ty>>;
+
+	struct text_output
+	{
+		std::string& sql;
+
+		template <typename _Ty>
+		void value(const _Ty& t)
+		{
+			append_sql_value(sql, t);
+		}
+	};
+
+	struct statement_output
+	{
+		std::string& sql;
+
+		std::vector<boost::mysql::field_view>& params;
+
+		std::deque<std::string>& storage;
+
+		template <typename _Ty>
+		void value(const _Ty& t)
+		{
+			sql += '?';
+
+			if constexpr (std::same_as<_Ty, std::string>)
+			{
+				params.push_back(boost::mysql::field_view(std::string_view(storage.emplace_back(t))));
+			}
+			else
+			{
+				params.push_back(to_field(t, storage));
+			}
+		}
+	};
+
+	template <typename _Derived>
+	class expression
+	{
+	public:
+		std::string sql() const
+		{
+			std::string result{};
+
+			append(result);
+
+			return result;
+		}
+
+		void append(std::string& sql) const
+		{
+			sql.reserve(sql.size() + self().size_hint() + 1);
+
+			sql += ' ';
+
+			text_output out{ sql };
+
+			self().render(out);
+		}
+
+		void prepare(std::string& sql, std::vector<boost::mysql::field_view>& params,
+					 std::deque<std::string>& storage) const
+		{
+			sql.reserve(sql.size() + self().size_hint() + 1);
+
+			sql += ' ';
+
+			statement_output out{ sql, params, storage };
+
+			self().render(out);
+		}
+
+	protected:
+		template <int Precedence, typename _Expr, typename _Out>
+		static void render_operand(const _Expr& expr, _Out& out)
+		{
+			if constexpr (_Expr::precedence > Precedence)
+			{
+				out.sql += LEFT_BRACKET;
+
+				expr.render(out);
+
+				out.sql += RIGHT_BRACKET;
+			}
+			else
+			{
+				expr.render(out);
+			}
+		}
+
+	private:
+		const _Derived& self() const
+		{
+			return static_cast<const _Derived&>(*this);
+		}
+	};
+
+	template <typename _Ty>
+	std::size_t value_size_hint(const _Ty& value)
+	{
+		if constexpr (std::convertible_to<const _Ty&, std::string_view>)
+		{
+			return std::string_view(value).size() + 2;
+		}
+		else
+		{
+			return 24;
+		}
+	}
+
+	template <typename _Ty>
+	class value_expr : public expression<value_expr<_Ty>>
+	{
+	public:
+		static constexpr int precedence = 0;
+
+	public:
+		explicit value_expr(_Ty value)
+			: value_(std::move(value))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			out.value(value_);
+		}
+
+		std::size_t size_hint() const
+		{
+			return value_size_hint(value_);
+		}
+
+	private:
+		_Ty value_;
+	};
+
+	template <typename _Ty>
+	auto make_operand(_Ty&& t)
+	{
+		if constexpr (expression_t<_Ty>)
+		{
+			return std::remove_cvref_t<_Ty>(std::forward<_Ty>(t));
+		}
+		else
+		{
+			return value_expr<expression_value_t<_Ty>>(std::forward<_Ty>(t));
+		}
+	}
+
+	template <typename _Ty>
+	using operand_t = decltype(make_operand(std::declval<_Ty>()));
+
+	template <typename _Left, typename _Right, const std::string_view& _Op>
+	class compare_expr : public expression<compare_expr<_Left, _Right, _Op>>
+	{
+		using base_type = expression<compare_expr<_Left, _Right, _Op>>;
+
+	public:
+		static constexpr int precedence = 1;
+
+	public:
+		compare_expr(_Left left, _Right right)
+			: left_(std::move(left))
+			, right_(std::move(right))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			base_type::template render_operand<0>(left_, out);
+
+			out.sql += SPACE;
+			out.sql += _Op;
+			out.sql += SPACE;
+
+			base_type::template render_operand<0>(right_, out);
+		}
+
+		std::size_t size_hint() const
+		{
+			return left_.size_hint() + _Op.size() + right_.size_hint() + 4;
+		}
+
+	private:
+		_Left left_;
+
+		_Right right_;
+	};
+
+	template <typename _Left, typename _Right, const std::string_view& _Op, int Precedence>
+	class logic_expr : public expression<logic_expr<_Left, _Right, _Op, Precedence>>
+	{
+		using base_type = expression<logic_expr<_Left, _Right, _Op, Precedence>>;
+
+	public:
+		static constexpr int precedence = Precedence;
+
+	public:
+		logic_expr(_Left left, _Right right)
+			: left_(std::move(left))
+			, right_(std::move(right))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			base_type::template render_operand<precedence>(left_, out);
+
+			out.sql += SPACE;
+			out.sql += _Op;
+			out.sql += SPACE;
+
+			base_type::template render_operand<precedence>(right_, out);
+		}
+
+		std::size_t size_hint() const
+		{
+			return left_.size_hint() + _Op.size() + right_.size_hint() + 6;
+		}
+
+	private:
+		_Left left_;
+
+		_Right right_;
+	};
+
+	template <typename _Expr>
+	class not_expr : public expression<not_expr<_Expr>>
+	{
+		using base_type = expression<not_expr<_Expr>>;
+
+	public:
+		static constexpr int precedence = 2;
+
+	public:
+		explicit not_expr(_Expr expr)
+			: expr_(std::move(expr))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			out.sql += LOGIC_NOT;
+			out.sql += SPACE;
+
+			base_type::template render_operand<0>(expr_, out);
+		}
+
+		std::size_t size_hint() const
+		{
+			return expr_.size_hint() + LOGIC_NOT.size() + 3;
+		}
+
+	private:
+		_Expr expr_;
+	};
+
+	template <typename _Expr>
+	class group_expr : public expression<group_expr<_Expr>>
+	{
+	public:
+		static constexpr int precedence = 0;
+
+	public:
+		explicit group_expr(_Expr expr)
+			: expr_(std::move(expr))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			out.sql += LEFT_BRACKET;
+
+			expr_.render(out);
+
+			out.sql += RIGHT_BRACKET;
+		}
+
+		std::size_t size_hint() const
+		{
+			return expr_.size_hint() + 2;
+		}
+
+	private:
+		_Expr expr_;
+	};
+
+	template <typename _Column, const std::string_view& _Op>
+	class postfix_expr : public expression<postfix_expr<_Column, _Op>>
+	{
+	public:
+		static constexpr int precedence = 1;
+
+	public:
+		explicit postfix_expr(_Column column)
+			: column_(std::move(column))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			column_.render(out);
+
+			out.sql += SPACE;
+			out.sql += _Op;
+		}
+
+		std::size_t size_hint() const
+		{
+			return column_.size_hint() + _Op.size() + 1;
+		}
+
+	private:
+		_Column column_;
+	};
+
+	template <typename _Column, typename _Low, typename _High>
+	class between_expr : public expression<between_expr<_Column, _Low, _High>>
+	{
+	public:
+		static constexpr int precedence = 1;
+
+	public:
+		between_expr(_Column column, _Low low, _High high)
+			: column_(std::move(column))
+			, low_(std::move(low))
+			, high_(std::move(high))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			column_.render(out);
+
+			out.sql += SPACE;
+			out.sql += BETWEEN;
+			out.sql += SPACE;
+
+			low_.render(out);
+
+			out.sql += SPACE;
+			out.sql += AND;
+			out.sql += SPACE;
+
+			high_.render(out);
+		}
+
+		std::size_t size_hint() const
+		{
+			return column_.size_hint() + low_.size_hint() + high_.size_hint() + BETWEEN.size() + AND.size() + 4;
+		}
+
+	private:
+		_Column column_;
+
+		_Low low_;
+
+		_High high_;
+	};
+
+	template <typename _Column, typename... _Values>
+	class in_expr : public expression<in_expr<_Column, _Values...>>
+	{
+	public:
+		static constexpr int precedence = 1;
+
+	public:
+		in_expr(_Column column, _Values... values)
+			: column_(std::move(column))
+			, values_(std::move(values)...)
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			column_.render(out);
+
+			out.sql += SPACE;
+			out.sql += IN;
+			out.sql += SPACE;
+			out.sql += LEFT_BRACKET;
+
+			std::apply(
+				[&](const auto&... values)
+				{
+					std::size_t pos = 0;
+
+					((pos++ == 0 ? void() : void(out.sql += COMMA), values.render(out)), ...);
+				},
+				values_);
+
+			out.sql += RIGHT_BRACKET;
+		}
+
+		std::size_t size_hint() const
+		{
+			return column_.size_hint() + IN.size() + 4 +
+				   std::apply([](const auto&... values) { return ((values.size_hint() + 1) + ... + 0); }, values_);
+		}
+
+	private:
+		_Column column_;
+
+		std::tuple<_Values...> values_;
+	};
+
+	template <typename _Column, typename _Range>
+	class in_range_expr : public expression<in_range_expr<_Column, _Range>>
+	{
+	public:
+		static constexpr int precedence = 1;
+
+	public:
+		in_range_expr(_Column column, _Range range)
+			: column_(std::move(column))
+			, range_(std::forward<_Range>(range))
+		{}
+
+	public:
+		template <typename _Out>
+		void render(_Out& out) const
+		{
+			column_.render(out);
+
+			out.sql += SPACE;
+			out.sql += IN;
+			out.sql += SPACE;
+			out.sql += LEFT_BRACKET;
+
+			if (std::empty(range_))
+				out.sql += NULL_VALUE;
+
+			std::size_t pos = 0;
+
+			for (const auto& value : range_)
+			{
+				if (pos++ != 0)
+					out.sql += COMMA;
+
+				out.value(value);
+			}
+
+			out.sql += RIGHT_BRACKET;
+		}
+
+		std::size_t size_hint() const
+		{
+			std::size_t size = column_.size_hint() + IN.size() + 4;
+
+			for (const auto& value : range_)
+			{
+				size += value_size_hint(value) + 1;
+			}
+
+			return size;
+		}
+
+	private:
+		_Column column_;
+
+		_Range range_;
+	};
+
+	template <expression_t _Left, expression_t _Right>
+	auto operator&(_Left&& left, _Right&& right)
+	{
+		return logic_expr<operand_t<_Left>, operand_t<_Right>, AND, 3>(make_operand(std::forward<_Left>(left)),
+																	   make_operand(std::forward<_Right>(right)));
+	}
+
+	template <expression_t _Left, expression_t _Right>
+	auto operator|(_Left&& left, _Right&& right)
+	{
+		return logic_expr<operand_t<_Left>, operand_t<_Right>, OR, 4>(make_operand(std::forward<_Left>(left)),
+																	  make_operand(std::forward<_Right>(right)));
+	}
+
+	template <expression_t _Expr>
+	auto operator!(_Expr&& expr)
+	{
+		return not_expr<operand_t<_Expr>>(make_operand(std::forward<_Expr>(expr)));
+	}
+
+	template <expression_t _Expr>
+	auto group(_Expr&& expr)
+	{
+		return group_expr<operand_t<_Expr>>(make_operand(std::forward<_Expr>(expr)));
+	}
+} // namespace aquarius
@@ -0,0 +1,231 @@
+#pragma once
+#include <aquarius/logger.hpp>
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/keyword.hpp>
+#include <aquarius/mysql/to_string.hpp>
+#include <boost/mysql.hpp>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aquarius
+{
+	template <std::size_t P, std::size_t S>
+	class decimal
+	{
+		static_assert(P <= 18 && S <= P, "decimal precision must fit in a 64-bit integer!");
+
+		static constexpr std::int64_t power(std::size_t exponent)
+		{
+			std::int64_t value = 1;
+
+			for (std::size_t i = 0; i < exponent; ++i)
+				value *= 10;
+
+			return value;
+		}
+
+		static constexpr std::int64_t scale = power(S);
+
+		static constexpr std::int64_t limit = power(P);
+
+	public:
+		constexpr decimal() = default;
+
+		constexpr decimal(std::int64_t integer)
+			: value_(integer * scale)
+		{}
+
+	public:
+		static constexpr decimal from_unscaled(std::int64_t value)
+		{
+			decimal result{};
+
+			result.value_ = value;
+
+			return result;
+		}
+
+		static decimal from_field(const boost::mysql::field_view& field)
+		{
+			switch (field.kind())
+			{
+			case boost::mysql::field_kind::string:
+			{
+				auto result = parse(field.get_string());
+
+				if (!result)
+				{
+					XLOG_ERROR() << "decimal<" << P << "," << S << "> parse failed: " << field.get_string();
+
+					return {};
+				}
+
+				return *result;
+			}
+			case boost::mysql::field_kind::int64:
+				return decimal(field.get_int64());
+			case boost::mysql::field_kind::uint64:
+				return decimal(static_cast<std::int64_t>(field.get_uint64()));
+			case boost::mysql::field_kind::double_:
+				return from_unscaled(static_cast<std::int64_t>(std::llround(field.get_double() * scale)));
+			default:
+				return {};
+			}
+		}
+
+		static constexpr std::optional<decimal> parse(std::string_view str)
+		{
+			bool negative = !str.empty() && str.front() == '-';
+
+			if (negative || (!str.empty() && str.front() == '+'))
+				str.remove_prefix(1);
+
+			auto pos = str.find('.');
+
+			auto integer_part = str.substr(0, pos);
+
+			auto fraction_part = pos == std::string_view::npos ? std::string_view{} : str.substr(pos + 1);
+
+			if (integer_part.empty() && fraction_part.empty())
+				return std::nullopt;
+
+			std::int64_t integer = 0;
+
+			std::size_t integer_digits = 0;
+
+			for (auto c : integer_part)
+			{
+				if (c < '0' || c > '9')
+					return std::nullopt;
+
+				if (integer == 0 && c == '0')
+					continue;
+
+				if (++integer_digits > P - S)
+					return std::nullopt;
+
+				integer = integer * 10 + (c - '0');
+			}
+
+			std::int64_t fraction = 0;
+
+			bool round_up = false;
+
+			for (std::size_t i = 0; i < fraction_part.size(); ++i)
+			{
+				auto c = fraction_part[i];
+
+				if (c < '0' || c > '9')
+					return std::nullopt;
+
+				if (i < S)
+					fraction = fraction * 10 + (c - '0');
+				else if (i == S)
+					round_up = c >= '5';
+			}
+
+			for (auto digits = fraction_part.size(); digits < S; ++digits)
+			{
+				fraction *= 10;
+			}
+
+			auto value = integer * scale + fraction + (round_up ? 1 : 0);
+
+			if (value >= limit)
+				return std::nullopt;
+
+			return from_unscaled(negative ? -value : value);
+		}
+
+		constexpr std::int64_t unscaled() const
+		{
+			return value_;
+		}
+
+		constexpr double to_double() const
+		{
+			return static_cast<double>(value_) / scale;
+		}
+
+		std::string to_string() const
+		{
+			auto abs = value_ < 0 ? -value_ : value_;
+
+			std::string result = value_ < 0 ? "-" : "";
+
+			result += std::to_string(abs / scale);
+
+			if constexpr (S != 0)
+			{
+				auto fraction = std::to_string(abs % scale);
+
+				result += '.';
+				result.append(S - fraction.size(), '0');
+				result += fraction;
+			}
+
+			return result;
+		}
+
+		constexpr auto operator<=>(const decimal&) const = default;
+
+	private:
+		std::int64_t value_ = 0;
+	};
+
+	template <std::size_t P, std::size_t S>
+	std::ostream& operator<<(std::ostream& os, const decimal<P, S>& value)
+	{
+		return os << value.to_string();
+	}
+
+	template <std::size_t P, std::size_t S>
+	constexpr auto mysql_type(indentify<decimal<P, S>>)
+	{
+		if constexpr (S == 0)
+		{
+			return concat_v<DECIMAL, LEFT_BRACKET, to_string<P>::value, RIGHT_BRACKET>.data();
+		}
+		else
+		{
+			return concat_v<DECIMAL, LEFT_BRACKET, to_string<P>::value, COMMA, to_string<S>::value, RIGHT_BRACKET>
+				.data();
+		}
+	}
+
+	template <typename _Duration>
+	constexpr auto mysql_type(indentify<std::chrono::sys_time<_Duration>>)
+	{
+		if constexpr (std::is_convertible_v<_Duration, std::chrono::seconds>)
+		{
+			return "datetime";
+		}
+		else
+		{
+			return "datetime(6)";
+		}
+	}
+
+	constexpr auto mysql_type(indentify<boost::mysql::datetime>)
+	{
+		return "datetime(6)";
+	}
+
+	constexpr auto mysql_type(indentify<std::vector<std::byte>>)
+	{
+		return "longblob";
+	}
+
+	constexpr auto mysql_type(indentify<std::vector<unsigned char>>)
+	{
+		return "longblob";
+	}
+} // namespace aquarius
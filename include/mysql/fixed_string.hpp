@@ -0,0 +1,142 @@
+#pragma once
+#include <aquarius/logger.hpp>
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/keyword.hpp>
+#include <aquarius/mysql/to_string.hpp>
+#include <boost/mysql.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace aquarius
+{
+	template <std::size_t N>
+	class fixed_string
+	{
+		static constexpr std::size_t max_bytes = N * 4;
+
+		using size_type = std::conditional_t<(max_bytes <= UINT8_MAX), std::uint8_t,
+											 std::conditional_t<(max_bytes <= UINT16_MAX), std::uint16_t, std::size_t>>;
+
+	public:
+		constexpr fixed_string() = default;
+
+		constexpr fixed_string(std::string_view value)
+		{
+			std::size_t bytes = 0;
+
+			std::size_t chars = 0;
+
+			while (bytes < value.size() && chars < N)
+			{
+				auto next = bytes + 1;
+
+				while (next < value.size() && is_continuation(value[next]))
+				{
+					++next;
+				}
+
+				if (next > max_bytes)
+					break;
+
+				bytes = next;
+
+				++chars;
+			}
+
+			size_ = static_cast<size_type>(bytes);
+
+			truncated_ = bytes < value.size();
+
+			std::copy_n(value.data(), bytes, data_.begin());
+		}
+
+		constexpr fixed_string(const char* value)
+			: fixed_string(std::string_view(value))
+		{}
+
+	public:
+		static fixed_string from_field(const boost::mysql::field_view& field)
+		{
+			if (!field.is_string())
+				return {};
+
+			fixed_string result(field.as_string());
+
+			if (result.truncated())
+			{
+				XLOG_ERROR() << "fixed_string<" << N << "> truncated: " << field.as_string();
+			}
+
+			return result;
+		}
+
+		static constexpr std::size_t capacity()
+		{
+			return N;
+		}
+
+		constexpr std::size_t size() const
+		{
+			return size_;
+		}
+
+		constexpr bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		constexpr bool truncated() const
+		{
+			return truncated_;
+		}
+
+		constexpr const char* data() const
+		{
+			return data_.data();
+		}
+
+		constexpr std::string_view view() const
+		{
+			return std::string_view(data_.data(), size_);
+		}
+
+		constexpr operator std::string_view() const
+		{
+			return view();
+		}
+
+		constexpr bool operator==(const fixed_string& other) const
+		{
+			return view() == other.view();
+		}
+
+	private:
+		static constexpr bool is_continuation(char c)
+		{
+			return (static_cast<unsigned char>(c) & 0xc0) == 0x80;
+		}
+
+	private:
+		std::array<char, max_bytes> data_{};
+
+		size_type size_ = 0;
+
+		bool truncated_ = false;
+	};
+
+	template <std::size_t N>
+	std::ostream& operator<<(std::ostream& os, const fixed_string<N>& value)
+	{
+		return os << value.view();
+	}
+
+	template <std::size_t N>
+	constexpr auto mysql_type(indentify<fixed_string<N>>)
+	{
+		return concat_v<VARCHAR, LEFT_BRACKET, to_string<N>::value, RIGHT_BRACKET>.data();
+	}
+} // namespace aquarius
@@ -1,10 +1,13 @@
 ﻿#pragma once
+#include <aquarius/mysql/algorithm.hpp>
 #include <aquarius/mysql/keyword.hpp>
 #include <aquarius/mysql/string_literal.hpp>
 #include <aquarius/type_traits.hpp>
 #include <array>
+#include <deque>
 #include <functional>
 #include <typeinfo>
+#include <vector>
 
 #pragma warning(disable : 4100)
 
@@ -24,17 +27,7 @@ namespace aquarius
 		aquarius::for_each(std::forward<_Ty>(t),
 						   [&](auto&& value)
 						   {
-							   using type = std::remove_cvref_t<decltype(value)>;
-							   if constexpr (std::same_as<type, std::string>)
-							   {
-								   sql += "'";
-								   sql += value;
-								   sql += "'";
-							   }
-							   else
-							   {
-								   sql += std::to_string(value);
-							   }
+							   append_sql_value(sql, value);
 
 							   sql += ",";
 						   });
@@ -45,6 +38,30 @@ namespace aquarius
 		sql += RIGHT_BRACKET;
 	}
 
+	template <std::string_view const& Keyword, typename _Ty>
+	void make_input_statement(std::string& sql, const _Ty& t, std::vector<boost::mysql::field_view>& params,
+							  std::deque<std::string>& storage)
+	{
+		constexpr static std::string_view table_name = name<_Ty>();
+
+		constexpr auto temp_sql_prev = concat_v<Keyword, SPACE, INTO, SPACE, table_name, SPACE, VALUES, LEFT_BRACKET>;
+
+		sql.append(temp_sql_prev.data());
+
+		aquarius::for_each(t,
+						   [&](auto&& value)
+						   {
+							   sql += "?,";
+
+							   params.push_back(to_field(value, storage));
+						   });
+
+		if (sql.back() == ',')
+			sql.pop_back();
+
+		sql += RIGHT_BRACKET;
+	}
+
 	template <typename _Ty, std::size_t... I>
 	constexpr auto get_tuple(_Ty&& tp, std::index_sequence<I...>)
 	{
@@ -85,6 +102,55 @@ namespace aquarius
 		}
 	}
 
+	template <typename _From, const std::string_view& Function, const std::string_view& Column>
+	void make_aggregate_sql(std::string& sql)
+	{
+		constexpr static auto table_name = name<_From>();
+
+		constexpr auto temp_sql =
+			concat_v<SELECT, SPACE, Function, LEFT_BRACKET, Column, RIGHT_BRACKET, SPACE, FROM, SPACE, table_name>;
+
+		sql = std::string(temp_sql.data(), temp_sql.size());
+	}
+
+	template <typename _Ty>
+	void append_join_columns(std::string& sql)
+	{
+		constexpr static auto table_name = name<_Ty>();
+
+		if constexpr (reflect_t<_Ty>)
+		{
+			for (auto field : field_names<_Ty>())
+			{
+				sql.append(table_name).append(DOT).append(field).append(COMMA).append(SPACE);
+			}
+		}
+		else
+		{
+			sql.append(table_name).append(DOT).append(ASTERISK).append(COMMA).append(SPACE);
+		}
+	}
+
+	template <typename _Left, typename _Right, const std::string_view& Keyword>
+	void make_join_sql(std::string& sql)
+	{
+		constexpr static auto left_name = name<_Left>();
+
+		constexpr static auto right_name = name<_Right>();
+
+		constexpr auto temp_sql = concat_v<SPACE, FROM, SPACE, left_name, SPACE, Keyword, SPACE, right_name, SPACE, ON>;
+
+		sql.assign(SELECT).append(SPACE);
+
+		append_join_columns<_Left>(sql);
+
+		append_join_columns<_Right>(sql);
+
+		sql.resize(sql.size() - concat_v<COMMA, SPACE>.size());
+
+		sql.append(temp_sql.data(), temp_sql.size());
+	}
+
 	template <typename _Ty>
 	void make_remove_sql(std::string& sql)
 	{
@@ -109,17 +175,7 @@ namespace aquarius
 						   {
 							   sql += concat_v<SET, SPACE, SPACE>;
 
-							   using type = std::remove_cvref_t<decltype(value)>;
-							   if constexpr (std::same_as<type, std::string>)
-							   {
-								   sql += "'";
-								   sql += value;
-								   sql += "'";
-							   }
-							   else
-							   {
-								   sql += std::to_string(value);
-							   }
+							   append_sql_value(sql, value);
 
 							   sql += ",";
 						   });
@@ -0,0 +1,187 @@
+#pragma once
+#include <boost/mysql.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace aquarius
+{
+	template <typename _Tag = void>
+	class string_dictionary
+	{
+		using value_type = std::shared_ptr<const std::string>;
+
+		struct hash
+		{
+			using is_transparent = void;
+
+			std::size_t operator()(std::string_view value) const
+			{
+				return std::hash<std::string_view>{}(value);
+			}
+
+			std::size_t operator()(const value_type& value) const
+			{
+				return std::hash<std::string_view>{}(*value);
+			}
+		};
+
+		struct equal
+		{
+			using is_transparent = void;
+
+			template <typename _Left, typename _Right>
+			bool operator()(const _Left& left, const _Right& right) const
+			{
+				return view(left) == view(right);
+			}
+
+			static std::string_view view(std::string_view value)
+			{
+				return value;
+			}
+
+			static std::string_view view(const value_type& value)
+			{
+				return *value;
+			}
+		};
+
+	public:
+		static constexpr std::size_t default_capacity = 4096;
+
+		explicit string_dictionary(std::size_t capacity = default_capacity)
+			: capacity_(capacity)
+		{}
+
+	public:
+		static string_dictionary& local()
+		{
+			thread_local string_dictionary dictionary{};
+
+			return dictionary;
+		}
+
+	public:
+		value_type intern(std::string_view value)
+		{
+			auto iter = values_.find(value);
+
+			if (iter != values_.end())
+				return *iter;
+
+			if (values_.size() >= capacity_ && ++overflow_ >= capacity_)
+				evict();
+
+			auto result = std::make_shared<const std::string>(value);
+
+			if (values_.size() < capacity_)
+				values_.insert(result);
+
+			return result;
+		}
+
+		std::size_t size() const
+		{
+			return values_.size();
+		}
+
+		std::size_t capacity() const
+		{
+			return capacity_;
+		}
+
+	private:
+		void evict()
+		{
+			overflow_ = 0;
+
+			std::erase_if(values_, [](const value_type& value) { return value.use_count() == 1; });
+		}
+
+	private:
+		std::size_t capacity_;
+
+		std::size_t overflow_ = 0;
+
+		std::unordered_set<value_type, hash, equal> values_;
+	};
+
+	template <typename _Tag = void>
+	class interned_string
+	{
+		using dictionary = string_dictionary<_Tag>;
+
+	public:
+		interned_string()
+			: interned_string(std::string_view{})
+		{}
+
+		interned_string(std::string_view value)
+			: value_(dictionary::local().intern(value))
+		{}
+
+		interned_string(const char* value)
+			: interned_string(std::string_view(value))
+		{}
+
+		interned_string(std::string_view value, dictionary& values)
+			: value_(values.intern(value))
+		{}
+
+	public:
+		static interned_string from_field(const boost::mysql::field_view& field)
+		{
+			if (!field.is_string())
+				return {};
+
+			return interned_string(field.as_string());
+		}
+
+		const std::string& str() const
+		{
+			return *value_;
+		}
+
+		std::string_view view() const
+		{
+			return *value_;
+		}
+
+		operator std::string_view() const
+		{
+			return *value_;
+		}
+
+		std::size_t size() const
+		{
+			return value_->size();
+		}
+
+		bool empty() const
+		{
+			return value_->empty();
+		}
+
+		bool shares(const interned_string& other) const
+		{
+			return value_ == other.value_;
+		}
+
+		bool operator==(const interned_string& other) const
+		{
+			return value_ == other.value_ || *value_ == *other.value_;
+		}
+
+	private:
+		std::shared_ptr<const std::string> value_;
+	};
+
+	template <typename _Tag>
+	std::ostream& operator<<(std::ostream& os, const interned_string<_Tag>& value)
+	{
+		return os << value.view();
+	}
+} // namespace aquarius
@@ -0,0 +1,184 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/column_map.hpp>
+#include <array>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace aquarius
+{
+	template <typename _Ty>
+	struct join_part
+	{
+		using type = _Ty;
+
+		static constexpr bool nullable = false;
+	};
+
+	template <typename _Ty>
+	struct join_part<std::optional<_Ty>>
+	{
+		using type = _Ty;
+
+		static constexpr bool nullable = true;
+	};
+
+	template <typename _Ty>
+	using join_part_t = typename join_part<_Ty>::type;
+
+	template <typename... _Parts>
+	constexpr auto join_offsets(std::tuple<_Parts...>*)
+	{
+		std::array<std::size_t, sizeof...(_Parts)> offsets{};
+
+		std::size_t offset = 0;
+
+		std::size_t pos = 0;
+
+		((offsets[pos++] = offset, offset += tuple_size_v<join_part_t<_Parts>>), ...);
+
+		return offsets;
+	}
+
+	template <typename _Tuple>
+	struct join_index;
+
+	template <typename... _Parts>
+	struct join_index<std::tuple<_Parts...>>
+	{
+		using type = std::tuple<std::array<std::size_t, tuple_size_v<join_part_t<_Parts>>>...>;
+	};
+
+	template <typename _Tuple>
+	using join_index_t = typename join_index<_Tuple>::type;
+
+	template <typename _Ty, typename _Meta, std::size_t N>
+	void map_join_part(const _Meta& meta, std::array<std::size_t, N>& index, std::size_t& offset,
+					   std::vector<bool>& used)
+	{
+		constexpr auto table_name = name<_Ty>();
+
+		index.fill(npos_column);
+
+		bool found = false;
+
+		std::size_t next = 0;
+
+		for (std::size_t column = 0; column < meta.size(); ++column)
+		{
+			if (used[column] || !detail::iequals(meta[column].table(), table_name))
+				continue;
+
+			found = true;
+
+			if constexpr (named_fields_t<_Ty>)
+			{
+				constexpr auto names = field_names<_Ty>();
+
+				for (std::size_t field = 0; field < N; ++field)
+				{
+					if (index[field] == npos_column && detail::iequals(names[field], meta[column].column_name()))
+					{
+						index[field] = column;
+
+						used[column] = true;
+
+						break;
+					}
+				}
+			}
+			else if (next < N)
+			{
+				index[next++] = column;
+
+				used[column] = true;
+			}
+		}
+
+		if (!found)
+		{
+			for (std::size_t field = 0; field < N; ++field)
+			{
+				index[field] = offset + field;
+			}
+		}
+
+		offset += N;
+	}
+
+	template <typename _Tuple, typename _Meta>
+	join_index_t<_Tuple> make_join_index(const _Meta& meta)
+	{
+		join_index_t<_Tuple> result{};
+
+		std::vector<bool> used(meta.size(), false);
+
+		std::size_t offset = 0;
+
+		[&]<std::size_t... I>(std::index_sequence<I...>)
+		{
+			(map_join_part<join_part_t<std::tuple_element_t<I, _Tuple>>>(meta, std::get<I>(result), offset, used), ...);
+		}(std::make_index_sequence<std::tuple_size_v<_Tuple>>{});
+
+		return result;
+	}
+
+	template <std::size_t Offset, std::size_t... I>
+	constexpr auto offset_index(std::index_sequence<I...>)
+	{
+		return std::array<std::size_t, sizeof...(I)>{ (Offset + I)... };
+	}
+
+	template <typename _Part, typename _Row, std::size_t N>
+	_Part to_join_part(const _Row& row, const std::array<std::size_t, N>& index)
+	{
+		using type = join_part_t<_Part>;
+
+		if constexpr (join_part<_Part>::nullable)
+		{
+			bool matched = false;
+
+			for (auto column : index)
+			{
+				if (column != npos_column && column < row.size() && !row[column].is_null())
+				{
+					matched = true;
+					break;
+				}
+			}
+
+			if (!matched)
+				return std::nullopt;
+		}
+
+		return to_struct<type>(row, index);
+	}
+
+	template <typename _Tuple, typename _Row, std::size_t... I>
+	_Tuple to_join(const _Row& row, std::index_sequence<I...>)
+	{
+		constexpr auto offsets = join_offsets(static_cast<_Tuple*>(nullptr));
+
+		return _Tuple{ to_join_part<std::tuple_element_t<I, _Tuple>>(
+			row, offset_index<offsets[I]>(std::make_index_sequence<tuple_size_v<join_part_t<std::tuple_element_t<I, _Tuple>>>>{}))... };
+	}
+
+	template <typename _Tuple, typename _Row, std::size_t... I>
+	_Tuple to_join(const _Row& row, const join_index_t<_Tuple>& index, std::index_sequence<I...>)
+	{
+		return _Tuple{ to_join_part<std::tuple_element_t<I, _Tuple>>(row, std::get<I>(index))... };
+	}
+
+	template <typename _Tuple, typename _Row>
+	_Tuple to_join(const _Row& row)
+	{
+		return to_join<_Tuple>(row, std::make_index_sequence<std::tuple_size_v<_Tuple>>{});
+	}
+
+	template <typename _Tuple, typename _Row>
+	_Tuple to_join(const _Row& row, const join_index_t<_Tuple>& index)
+	{
+		return to_join<_Tuple>(row, index, std::make_index_sequence<std::tuple_size_v<_Tuple>>{});
+	}
+} // namespace aquarius
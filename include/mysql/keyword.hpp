@@ -72,6 +72,64 @@ namespace aquarius
 
 	inline constexpr std::string_view HAVING = "having"sv;
 
+	inline constexpr std::string_view MIN = "min"sv;
+
+	inline constexpr std::string_view MAX = "max"sv;
+
+	inline constexpr std::string_view COUNT = "count"sv;
+
+	inline constexpr std::string_view SUM = "sum"sv;
+
+	inline constexpr std::string_view VARCHAR = "varchar"sv;
+
+	inline constexpr std::string_view DECIMAL = "decimal"sv;
+
+	inline constexpr std::string_view NOT_EQUAL = "!="sv;
+
+	inline constexpr std::string_view LESS_EQUAL = "<="sv;
+
+	inline constexpr std::string_view GREATER_EQUAL = ">="sv;
+
+	inline constexpr std::string_view IN = "in"sv;
+
+	inline constexpr std::string_view LIKE = "like"sv;
+
+	inline constexpr std::string_view IS_NOT_NULL = "is not null"sv;
+
+	inline constexpr std::string_view LOGIC_NOT = "not"sv;
+
+	inline constexpr std::string_view NULL_VALUE = "null"sv;
+
+	inline constexpr std::string_view JOIN = "join"sv;
+
+	inline constexpr std::string_view LEFT = "left"sv;
+
+	inline constexpr std::string_view ON = "on"sv;
+
+	inline constexpr std::string_view DOT = "."sv;
+
+	inline constexpr std::string_view FORCE = "force"sv;
+
+	inline constexpr std::string_view USE = "use"sv;
+
+	inline constexpr std::string_view IGNORE = "ignore"sv;
+
+	inline constexpr std::string_view INDEX = "index"sv;
+
+	inline constexpr std::string_view STRAIGHT_JOIN = "straight_join"sv;
+
+	inline constexpr std::string_view SQL_BUFFER_RESULT = "sql_buffer_result"sv;
+
+	inline constexpr std::string_view MAX_EXECUTION_TIME = "max_execution_time"sv;
+
+	inline constexpr std::string_view HINT_BEGIN = "/*+"sv;
+
+	inline constexpr std::string_view EXPLAIN = "explain"sv;
+
+	inline constexpr std::string_view FORMAT_JSON = "format=json"sv;
+
+	inline constexpr std::string_view HINT_END = "*/"sv;
+
 	template <class T>
 	struct indentify
 	{};
@@ -0,0 +1,597 @@
+#pragma once
+#include <boost/mysql.hpp>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aquarius
+{
+	struct histogram_snapshot
+	{
+		std::uint64_t count = 0;
+
+		std::uint64_t sum = 0;
+
+		std::uint64_t max = 0;
+
+		std::uint64_t p50 = 0;
+
+		std::uint64_t p90 = 0;
+
+		std::uint64_t p99 = 0;
+
+		std::uint64_t p999 = 0;
+
+		std::vector<std::pair<std::uint64_t, std::uint64_t>> buckets;
+	};
+
+	class latency_histogram
+	{
+		static constexpr std::size_t sub_bucket_bits = 4;
+
+		static constexpr std::size_t sub_bucket_count = std::size_t(1) << sub_bucket_bits;
+
+		static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+	public:
+		latency_histogram() = default;
+
+		~latency_histogram() = default;
+
+	public:
+		void record(std::uint64_t value)
+		{
+			counts_[index(value)].fetch_add(1, std::memory_order_relaxed);
+
+			count_.fetch_add(1, std::memory_order_relaxed);
+
+			sum_.fetch_add(value, std::memory_order_relaxed);
+
+			auto current = max_.load(std::memory_order_relaxed);
+
+			while (current < value && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		std::uint64_t count() const
+		{
+			return count_.load(std::memory_order_relaxed);
+		}
+
+		std::uint64_t percentile(double quantile) const
+		{
+			auto total = count();
+
+			if (total == 0)
+				return 0;
+
+			auto target = static_cast<std::uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+
+			std::uint64_t seen = 0;
+
+			for (std::size_t i = 0; i < bucket_count; ++i)
+			{
+				seen += counts_[i].load(std::memory_order_relaxed);
+
+				if (seen >= target)
+					return std::min(upper_bound(i), max_.load(std::memory_order_relaxed));
+			}
+
+			return max_.load(std::memory_order_relaxed);
+		}
+
+		histogram_snapshot snapshot(const std::vector<std::uint64_t>& bounds = default_bounds()) const
+		{
+			histogram_snapshot result{};
+
+			result.count = count();
+			result.sum = sum_.load(std::memory_order_relaxed);
+			result.max = max_.load(std::memory_order_relaxed);
+			result.p50 = percentile(0.5);
+			result.p90 = percentile(0.9);
+			result.p99 = percentile(0.99);
+			result.p999 = percentile(0.999);
+
+			std::size_t bucket = 0;
+
+			std::uint64_t cumulative = 0;
+
+			for (auto bound : bounds)
+			{
+				for (; bucket < bucket_count && upper_bound(bucket) <= bound; ++bucket)
+				{
+					cumulative += counts_[bucket].load(std::memory_order_relaxed);
+				}
+
+				result.buckets.emplace_back(bound, cumulative);
+			}
+
+			return result;
+		}
+
+		void reset()
+		{
+			for (auto& bucket : counts_)
+			{
+				bucket.store(0, std::memory_order_relaxed);
+			}
+
+			count_.store(0, std::memory_order_relaxed);
+			sum_.store(0, std::memory_order_relaxed);
+			max_.store(0, std::memory_order_relaxed);
+		}
+
+		static const std::vector<std::uint64_t>& default_bounds()
+		{
+			static const std::vector<std::uint64_t> bounds = []
+			{
+				std::vector<std::uint64_t> result{};
+
+				for (std::uint64_t bound = 1024; bound <= (std::uint64_t(1) << 36); bound <<= 2)
+				{
+					result.push_back(bound);
+				}
+
+				return result;
+			}();
+
+			return bounds;
+		}
+
+	private:
+		static std::size_t index(std::uint64_t value)
+		{
+			if (value < sub_bucket_count)
+				return static_cast<std::size_t>(value);
+
+			auto shift = static_cast<std::size_t>(std::bit_width(value)) - sub_bucket_bits - 1;
+
+			return (shift + 1) * sub_bucket_count + static_cast<std::size_t>((value >> shift) - sub_bucket_count);
+		}
+
+		static std::uint64_t upper_bound(std::size_t bucket)
+		{
+			if (bucket < sub_bucket_count)
+				return bucket;
+
+			auto shift = bucket / sub_bucket_count - 1;
+
+			auto base = (sub_bucket_count + bucket % sub_bucket_count) << shift;
+
+			return base + ((std::uint64_t(1) << shift) - 1);
+		}
+
+	private:
+		std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+
+		std::atomic<std::uint64_t> count_{ 0 };
+
+		std::atomic<std::uint64_t> sum_{ 0 };
+
+		std::atomic<std::uint64_t> max_{ 0 };
+	};
+
+	struct error_count
+	{
+		const boost::system::error_category* category = nullptr;
+
+		int code = 0;
+
+		std::uint64_t count = 0;
+	};
+
+	class error_counter
+	{
+		static constexpr std::size_t slot_count = 64;
+
+		enum slot_state : int
+		{
+			empty,
+			claiming,
+			ready
+		};
+
+	public:
+		void record(const boost::mysql::error_code& ec)
+		{
+			auto category = &ec.category();
+
+			auto code = ec.value();
+
+			auto start = (std::hash<const void*>{}(category) ^ static_cast<unsigned>(code) * 2654435761u) % slot_count;
+
+			for (std::size_t i = 0; i < slot_count; ++i)
+			{
+				auto& slot = slots_[(start + i) % slot_count];
+
+				auto state = slot.state.load(std::memory_order_acquire);
+
+				if (state == empty && slot.state.compare_exchange_strong(state, claiming, std::memory_order_acquire))
+				{
+					slot.category = category;
+					slot.code = code;
+
+					slot.state.store(ready, std::memory_order_release);
+
+					state = ready;
+				}
+
+				while (state == claiming)
+				{
+					state = slot.state.load(std::memory_order_acquire);
+				}
+
+				if (slot.category == category && slot.code == code)
+				{
+					slot.count.fetch_add(1, std::memory_order_relaxed);
+
+					return;
+				}
+			}
+
+			overflow_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		std::vector<error_count> snapshot() const
+		{
+			std::vector<error_count> result{};
+
+			for (auto& slot : slots_)
+			{
+				if (slot.state.load(std::memory_order_acquire) == ready)
+					result.push_back({ slot.category, slot.code, slot.count.load(std::memory_order_relaxed) });
+			}
+
+			if (auto overflow = overflow_.load(std::memory_order_relaxed); overflow != 0)
+				result.push_back({ nullptr, -1, overflow });
+
+			return result;
+		}
+
+		void reset()
+		{
+			for (auto& slot : slots_)
+			{
+				slot.count.store(0, std::memory_order_relaxed);
+			}
+
+			overflow_.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		struct slot
+		{
+			std::atomic<int> state{ empty };
+
+			const boost::system::error_category* category = nullptr;
+
+			int code = 0;
+
+			std::atomic<std::uint64_t> count{ 0 };
+		};
+
+		std::array<slot, slot_count> slots_{};
+
+		std::atomic<std::uint64_t> overflow_{ 0 };
+	};
+
+	struct metrics_snapshot
+	{
+		std::uint64_t acquires = 0;
+
+		std::uint64_t queries = 0;
+
+		std::uint64_t errors = 0;
+
+		std::uint64_t rows = 0;
+
+		std::uint64_t bytes = 0;
+
+		std::uint64_t connections_created = 0;
+
+		std::uint64_t live = 0;
+
+		std::uint64_t idle = 0;
+
+		std::uint64_t in_use = 0;
+
+		histogram_snapshot acquire_wait;
+
+		histogram_snapshot execute_latency;
+
+		std::vector<error_count> errors_by_code;
+	};
+
+	class pool_metrics
+	{
+	public:
+		pool_metrics() = default;
+
+		~pool_metrics() = default;
+
+	public:
+		void connection_created()
+		{
+			live_.fetch_add(1, std::memory_order_relaxed);
+
+			connections_created_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void connection_closed()
+		{
+			live_.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void track_bytes(bool value)
+		{
+			track_bytes_.store(value, std::memory_order_relaxed);
+		}
+
+		bool tracking_bytes() const
+		{
+			return track_bytes_.load(std::memory_order_relaxed);
+		}
+
+		void acquired(std::uint64_t wait_ns)
+		{
+			acquires_.fetch_add(1, std::memory_order_relaxed);
+
+			in_use_.fetch_add(1, std::memory_order_relaxed);
+
+			acquire_wait_.record(wait_ns);
+		}
+
+		void released()
+		{
+			in_use_.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void executed(std::uint64_t latency_ns, const boost::mysql::error_code& ec)
+		{
+			queries_.fetch_add(1, std::memory_order_relaxed);
+
+			execute_latency_.record(latency_ns);
+
+			if (ec)
+			{
+				errors_.fetch_add(1, std::memory_order_relaxed);
+
+				errors_by_code_.record(ec);
+			}
+		}
+
+		void decoded(std::uint64_t rows, std::uint64_t bytes)
+		{
+			rows_.fetch_add(rows, std::memory_order_relaxed);
+
+			bytes_.fetch_add(bytes, std::memory_order_relaxed);
+		}
+
+		metrics_snapshot snapshot(std::uint64_t idle) const
+		{
+			metrics_snapshot result{};
+
+			result.acquires = acquires_.load(std::memory_order_relaxed);
+			result.queries = queries_.load(std::memory_order_relaxed);
+			result.errors = errors_.load(std::memory_order_relaxed);
+			result.rows = rows_.load(std::memory_order_relaxed);
+			result.bytes = bytes_.load(std::memory_order_relaxed);
+			result.connections_created = connections_created_.load(std::memory_order_relaxed);
+			result.live = live_.load(std::memory_order_relaxed);
+			result.idle = idle;
+			result.in_use = in_use_.load(std::memory_order_relaxed);
+			result.acquire_wait = acquire_wait_.snapshot();
+			result.execute_latency = execute_latency_.snapshot();
+			result.errors_by_code = errors_by_code_.snapshot();
+
+			return result;
+		}
+
+		void reset()
+		{
+			acquires_.store(0, std::memory_order_relaxed);
+			queries_.store(0, std::memory_order_relaxed);
+			errors_.store(0, std::memory_order_relaxed);
+			rows_.store(0, std::memory_order_relaxed);
+			bytes_.store(0, std::memory_order_relaxed);
+
+			acquire_wait_.reset();
+			execute_latency_.reset();
+			errors_by_code_.reset();
+		}
+
+	private:
+		std::atomic<std::uint64_t> acquires_{ 0 };
+
+		std::atomic<std::uint64_t> queries_{ 0 };
+
+		std::atomic<std::uint64_t> errors_{ 0 };
+
+		std::atomic<std::uint64_t> rows_{ 0 };
+
+		std::atomic<std::uint64_t> bytes_{ 0 };
+
+		std::atomic<std::uint64_t> connections_created_{ 0 };
+
+		std::atomic<std::uint64_t> live_{ 0 };
+
+		std::atomic<std::uint64_t> in_use_{ 0 };
+
+		std::atomic<bool> track_bytes_{ false };
+
+		latency_histogram acquire_wait_;
+
+		latency_histogram execute_latency_;
+
+		error_counter errors_by_code_;
+	};
+
+	inline std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+	{
+		return static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	template <typename _Row>
+	std::uint64_t row_bytes(const _Row& row)
+	{
+		std::uint64_t bytes = 0;
+
+		for (auto field : row)
+		{
+			if (field.is_string())
+			{
+				bytes += field.get_string().size();
+			}
+			else if (field.is_blob())
+			{
+				bytes += field.get_blob().size();
+			}
+			else if (!field.is_null())
+			{
+				bytes += sizeof(std::uint64_t);
+			}
+		}
+
+		return bytes;
+	}
+
+	template <typename _Rows>
+	std::uint64_t rows_bytes(const _Rows& rows)
+	{
+		std::uint64_t bytes = 0;
+
+		for (auto row : rows)
+		{
+			bytes += row_bytes(row);
+		}
+
+		return bytes;
+	}
+
+	namespace detail
+	{
+		inline void append_seconds(std::string& text, std::uint64_t ns)
+		{
+			char buffer[32]{};
+
+			auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(ns) / 1e9);
+
+			text.append(buffer, end);
+		}
+
+		inline void append_metric(std::string& text, std::string_view prefix, std::string_view name,
+								  std::string_view type, std::uint64_t value)
+		{
+			text += "# TYPE ";
+			text += prefix;
+			text += name;
+			text += ' ';
+			text += type;
+			text += '\n';
+			text += prefix;
+			text += name;
+			text += ' ';
+			text += std::to_string(value);
+			text += '\n';
+		}
+
+		inline void append_histogram(std::string& text, std::string_view prefix, std::string_view name,
+									 const histogram_snapshot& histogram)
+		{
+			text += "# TYPE ";
+			text += prefix;
+			text += name;
+			text += " histogram\n";
+
+			for (auto& [bound, count] : histogram.buckets)
+			{
+				text += prefix;
+				text += name;
+				text += "_bucket{le=\"";
+				append_seconds(text, bound);
+				text += "\"} ";
+				text += std::to_string(count);
+				text += '\n';
+			}
+
+			text += prefix;
+			text += name;
+			text += "_bucket{le=\"+Inf\"} ";
+			text += std::to_string(histogram.count);
+			text += '\n';
+
+			text += prefix;
+			text += name;
+			text += "_sum ";
+			append_seconds(text, histogram.sum);
+			text += '\n';
+
+			text += prefix;
+			text += name;
+			text += "_count ";
+			text += std::to_string(histogram.count);
+			text += '\n';
+		}
+	} // namespace detail
+
+	inline std::string to_prometheus(const metrics_snapshot& snapshot, std::string_view prefix = "aquarius_mysql_")
+	{
+		std::string text{};
+
+		text.reserve(4096);
+
+		detail::append_metric(text, prefix, "acquires_total", "counter", snapshot.acquires);
+		detail::append_metric(text, prefix, "queries_total", "counter", snapshot.queries);
+		detail::append_metric(text, prefix, "errors_total", "counter", snapshot.errors);
+		detail::append_metric(text, prefix, "rows_decoded_total", "counter", snapshot.rows);
+		detail::append_metric(text, prefix, "bytes_decoded_total", "counter", snapshot.bytes);
+		detail::append_metric(text, prefix, "connections_created_total", "counter", snapshot.connections_created);
+
+		text += "# TYPE ";
+		text += prefix;
+		text += "connections gauge\n";
+
+		for (auto [state, value] : { std::pair<std::string_view, std::uint64_t>{ "live", snapshot.live },
+									 std::pair<std::string_view, std::uint64_t>{ "idle", snapshot.idle },
+									 std::pair<std::string_view, std::uint64_t>{ "in_use", snapshot.in_use } })
+		{
+			text += prefix;
+			text += "connections{state=\"";
+			text += state;
+			text += "\"} ";
+			text += std::to_string(value);
+			text += '\n';
+		}
+
+		text += "# TYPE ";
+		text += prefix;
+		text += "errors_by_code_total counter\n";
+
+		for (auto& error : snapshot.errors_by_code)
+		{
+			text += prefix;
+			text += "errors_by_code_total{category=\"";
+			text += error.category != nullptr ? error.category->name() : "";
+			text += "\",code=\"";
+			text += std::to_string(error.code);
+			text += "\"} ";
+			text += std::to_string(error.count);
+			text += '\n';
+		}
+
+		detail::append_histogram(text, prefix, "acquire_wait_seconds", snapshot.acquire_wait);
+		detail::append_histogram(text, prefix, "execute_latency_seconds", snapshot.execute_latency);
+
+		return text;
+	}
+} // namespace aquarius
@@ -2,14 +2,26 @@
 #include <aquarius/io_service_pool.hpp>
 #include <aquarius/logger.hpp>
 #include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/column_map.hpp>
+#include <aquarius/mysql/column_result.hpp>
+#include <aquarius/mysql/metrics.hpp>
+#include <aquarius/mysql/pmr_result.hpp>
+#include <aquarius/mysql/result_view.hpp>
+#include <aquarius/mysql/tracing.hpp>
 #include <boost/mysql.hpp>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace aquarius
 {
 	class mysql_connect final
 	{
+		static constexpr std::size_t statement_capacity = 256;
+
 	public:
 		template <typename _Endpoint, typename _Param>
 		explicit mysql_connect(boost::asio::io_service& ios, _Endpoint&& host, _Param&& param)
@@ -27,6 +39,8 @@ namespace aquarius
 	public:
 		void close()
 		{
+			close_statements();
+
 			mysql_ptr_->async_quit(
 				[&](const boost::mysql::error_code& ec)
 				{
@@ -40,6 +54,28 @@ namespace aquarius
 				});
 		}
 
+		std::uint64_t last_bytes() const
+		{
+			return last_bytes_;
+		}
+
+		void count_bytes(bool value)
+		{
+			count_bytes_ = value;
+		}
+
+		std::uint64_t connection_id() const
+		{
+			return connection_id_.load(std::memory_order_relaxed);
+		}
+
+		bool wait_ready() const
+		{
+			ready_.wait(false, std::memory_order_acquire);
+
+			return connection_id() != 0;
+		}
+
 		void set_charset(const std::string& charset = "utf8mb4")
 		{
 			boost::mysql::results result;
@@ -60,68 +96,380 @@ namespace aquarius
 
 		bool execute(const std::string& sql, boost::mysql::error_code& ec)
 		{
+			scoped_span span(span_name::execute);
+
 			boost::mysql::results result{};
 			boost::mysql::diagnostics diag{};
 
 			mysql_ptr_->execute(sql, result, ec, diag);
 
+			span.set_error(ec);
+
+			return result.has_value();
+		}
+
+		bool execute(const std::string& sql, const std::vector<boost::mysql::field_view>& params,
+					 boost::mysql::error_code& ec)
+		{
+			scoped_span span(span_name::execute);
+
+			boost::mysql::diagnostics diag{};
+
+			auto stmt = prepare(sql, ec, diag);
+
+			if (ec)
+			{
+				span.set_error(ec);
+
+				return false;
+			}
+
+			boost::mysql::results result{};
+
+			mysql_ptr_->execute(stmt.bind(params.begin(), params.end()), result, ec, diag);
+
+			span.set_error(ec);
+
 			return result.has_value();
 		}
 
 		template <typename _Func>
-		auto async_excute(std::string_view sql, _Func&& f)
+		void async_excute(std::string_view sql, _Func&& f)
+		{
+			auto text = std::make_shared<std::string>(sql);
+
+			auto result = std::make_shared<boost::mysql::results>();
+
+			scoped_span span(span_name::execute, scoped_span::current(), {}, false);
+
+			mysql_ptr_->async_execute(*text, *result, executed(text, result, std::forward<_Func>(f), std::move(span)));
+		}
+
+		template <typename _Func>
+		void async_excute(std::string_view sql, std::shared_ptr<const std::vector<boost::mysql::field>> params,
+						  _Func&& f)
+		{
+			auto text = std::make_shared<std::string>(sql);
+
+			auto result = std::make_shared<boost::mysql::results>();
+
+			scoped_span span(span_name::execute, scoped_span::current(), {}, false);
+
+			async_prepare(*text,
+						  [this, text, result, params, func = std::forward<_Func>(f), span = std::move(span)](
+							  const boost::mysql::error_code& ec, boost::mysql::statement stmt) mutable
+						  {
+							  if (ec)
+								  return executed(text, result, std::move(func), std::move(span))(ec);
+
+							  mysql_ptr_->async_execute(
+								  stmt.bind(params->begin(), params->end()), *result,
+								  executed(text, result, std::move(func), std::move(span), params));
+						  });
+		}
+
+		template <typename _Ty, string_literal... args>
+		bool query(const std::string& sql, std::vector<_Ty>& t, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params = {})
 		{
 			boost::mysql::results result{};
+			boost::mysql::diagnostics diag{};
 
-			return mysql_ptr_->async_execute(sql, result,
-											 [&](const boost::mysql::error_code& ec)
-											 {
-												 if (ec)
-												 {
-													 XLOG_ERROR() << "failed at excute sql:" << sql;
-													 f(false);
-													 return;
-												 }
+			run(sql, params, result, ec, diag);
 
-												 f(true);
-											 });
+			if (!result.has_value())
+				return false;
+
+			last_bytes_ = count_bytes_ ? rows_bytes(result.rows()) : 0;
+
+			t = make_result<_Ty, args...>(result);
+
+			return true;
 		}
 
 		template <typename _Ty>
-		bool query(const std::string& sql, std::vector<_Ty>& t, boost::mysql::error_code& ec)
+		bool query(const std::string& sql, pmr_result<_Ty>& t, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params = {})
 		{
 			boost::mysql::results result{};
 			boost::mysql::diagnostics diag{};
 
-			mysql_ptr_->query(sql, result, ec, diag);
+			run(sql, params, result, ec, diag);
 
 			if (!result.has_value())
 				return false;
 
-			t = make_result<_Ty>(result);
+			last_bytes_ = count_bytes_ ? rows_bytes(result.rows()) : 0;
+
+			scoped_span span(span_name::decode);
+
+			span.set_attribute("db.rows", result.rows().size());
+
+			if constexpr (named_fields_t<_Ty>)
+			{
+				t = make_pmr_result<_Ty>(result.rows(), column_map<_Ty>::get(result.meta()));
+			}
+			else
+			{
+				t = make_pmr_result<_Ty>(result.rows());
+			}
 
 			return true;
 		}
 
-		template <typename _Ty, typename _Func>
-		auto async_query(const std::string& sql, _Func&& f)
+		template <typename _Ty>
+		bool query(const std::string& sql, column_result<_Ty>& t, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params = {})
 		{
 			boost::mysql::results result{};
+			boost::mysql::diagnostics diag{};
+
+			run(sql, params, result, ec, diag);
+
+			if (!result.has_value())
+				return false;
+
+			last_bytes_ = count_bytes_ ? rows_bytes(result.rows()) : 0;
+
+			scoped_span span(span_name::decode);
+
+			span.set_attribute("db.rows", result.rows().size());
+
+			if constexpr (named_fields_t<_Ty>)
+			{
+				t = make_column_result<_Ty>(result.rows(), column_map<_Ty>::get(result.meta()));
+			}
+			else
+			{
+				t = make_column_result<_Ty>(result.rows());
+			}
+
+			return true;
+		}
+
+		template <typename _Ty>
+		bool query(const std::string& sql, std::optional<_Ty>& t, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params = {})
+		{
+			boost::mysql::results result{};
+			boost::mysql::diagnostics diag{};
+
+			run(sql, params, result, ec, diag);
+
+			if (!result.has_value())
+				return false;
+
+			last_bytes_ = count_bytes_ ? rows_bytes(result.rows()) : 0;
+
+			auto rows = result.rows();
+
+			if (rows.empty() || rows[0].empty() || rows[0][0].is_null())
+				return true;
+
+			t = cast<_Ty>(rows[0][0]);
+
+			return true;
+		}
+
+		template <typename _Ty>
+		bool query(const std::string& sql, result_view<_Ty>& t, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params = {})
+		{
+			boost::mysql::diagnostics diag{};
+
+			run(sql, params, t.results(), ec, diag);
+
+			if (!t.results().has_value())
+				return false;
+
+			last_bytes_ = count_bytes_ ? rows_bytes(t.results().rows()) : 0;
+
+			t.map_columns();
+
+			return true;
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, _Func&& f, boost::mysql::error_code& ec)
+		{
+			return read_rows(sql, std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f,
+						boost::mysql::error_code& ec)
+		{
+			if (params.empty())
+				return read_rows(sql, std::forward<_Func>(f), ec);
+
+			boost::mysql::diagnostics diag{};
+
+			auto stmt = prepare(sql, ec, diag);
+
+			if (ec)
+				return false;
+
+			return read_rows(stmt.bind(params.begin(), params.end()), std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
+		void async_query(const std::string& sql, _Func&& f)
+		{
+			auto text = std::make_shared<std::string>(sql);
+
+			auto result = std::make_shared<boost::mysql::results>();
+
+			auto parent = scoped_span::current();
+
+			scoped_span span(span_name::execute, parent, {}, false);
+
+			mysql_ptr_->async_query(
+				*text, *result, queried<_Ty, args...>(text, result, std::forward<_Func>(f), parent, std::move(span)));
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
+		void async_query(const std::string& sql, std::shared_ptr<const std::vector<boost::mysql::field>> params,
+						 _Func&& f)
+		{
+			auto text = std::make_shared<std::string>(sql);
+
+			auto result = std::make_shared<boost::mysql::results>();
+
+			auto parent = scoped_span::current();
+
+			scoped_span span(span_name::execute, parent, {}, false);
 
-			return mysql_ptr_->async_query(sql, result,
-										   [&, func = std::move(f)](const boost::mysql::error_code& ec) mutable
-										   {
-											   if (ec)
-											   {
-												   XLOG_ERROR() << "failed at excute sql:" << sql;
-												   return;
-											   }
+			async_prepare(*text,
+						  [this, text, result, params, parent, func = std::forward<_Func>(f), span = std::move(span)](
+							  const boost::mysql::error_code& ec, boost::mysql::statement stmt) mutable
+						  {
+							  if (ec)
+								  return queried<_Ty, args...>(text, result, std::move(func), parent,
+															   std::move(span))(ec);
 
-											   func(make_result<_Ty>(result));
-										   });
+							  mysql_ptr_->async_execute(
+								  stmt.bind(params->begin(), params->end()), *result,
+								  queried<_Ty, args...>(text, result, std::move(func), parent, std::move(span),
+														params));
+						  });
 		}
 
 	private:
+		template <typename _Statement, typename _Func>
+		bool read_rows(const _Statement& stmt, _Func&& f, boost::mysql::error_code& ec)
+		{
+			boost::mysql::execution_state state{};
+			boost::mysql::diagnostics diag{};
+
+			{
+				scoped_span span(span_name::execute);
+
+				mysql_ptr_->start_execution(stmt, state, ec, diag);
+
+				span.set_error(ec);
+			}
+
+			scoped_span span(span_name::read);
+
+			std::size_t count = 0;
+
+			while (!ec && !state.complete())
+			{
+				auto rows = mysql_ptr_->read_some_rows(state, ec, diag);
+
+				count += rows.size();
+
+				for (auto row : rows)
+				{
+					f(row, state.meta());
+				}
+			}
+
+			span.set_attribute("db.rows", count);
+
+			span.set_error(ec);
+
+			if (ec && (!is_server_error(ec) || state.should_read_head() || state.should_read_rows()))
+				reset();
+
+			return !ec;
+		}
+
+		template <typename _Func>
+		static auto executed(std::shared_ptr<std::string> text, std::shared_ptr<boost::mysql::results> result,
+							 _Func&& f, scoped_span&& span,
+							 std::shared_ptr<const std::vector<boost::mysql::field>> params = nullptr)
+		{
+			return [text = std::move(text), result = std::move(result), params = std::move(params),
+					func = std::forward<_Func>(f), span = std::move(span)](const boost::mysql::error_code& ec) mutable
+			{
+				span.set_error(ec);
+
+				span.end();
+
+				if (ec)
+				{
+					XLOG_ERROR() << "failed at excute sql:" << *text;
+				}
+
+				func(!ec, ec);
+			};
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
+		auto queried(std::shared_ptr<std::string> text, std::shared_ptr<boost::mysql::results> result, _Func&& f,
+					 trace_span* parent, scoped_span&& span,
+					 std::shared_ptr<const std::vector<boost::mysql::field>> params = nullptr)
+		{
+			return [this, text = std::move(text), result = std::move(result), params = std::move(params),
+					func = std::forward<_Func>(f), parent,
+					span = std::move(span)](const boost::mysql::error_code& ec) mutable
+			{
+				span.set_error(ec);
+
+				span.end();
+
+				if (ec)
+				{
+					XLOG_ERROR() << "failed at excute sql:" << *text;
+
+					func(std::vector<_Ty>{}, ec);
+
+					return;
+				}
+
+				func(make_result<_Ty, args...>(*result, parent), ec);
+			};
+		}
+
+		template <typename _Func>
+		void async_prepare(const std::string& sql, _Func&& f)
+		{
+			auto iter = statements_.find(sql);
+
+			if (iter != statements_.end())
+				return f(boost::mysql::error_code{}, iter->second);
+
+			if (statements_.size() >= statement_capacity)
+				close_statements();
+
+			mysql_ptr_->async_prepare_statement(
+				sql, [this, text = sql, func = std::forward<_Func>(f)](const boost::mysql::error_code& ec,
+																		boost::mysql::statement stmt) mutable
+				{
+					if (ec)
+					{
+						XLOG_ERROR() << "failed at prepare sql:" << text;
+					}
+					else
+					{
+						statements_.emplace(text, stmt);
+					}
+
+					func(ec, stmt);
+				});
+		}
+
 		void run()
 		{
 			mysql_ptr_->async_connect(*endpoint_.begin(), *params_,
@@ -130,26 +478,172 @@ namespace aquarius
 										  if (ec)
 										  {
 											  XLOG_ERROR() << "mysql connect error! " << ec.what();
+
+											  set_ready();
+
 											  return;
 										  }
 
 										  XLOG_INFO() << "msyql async connect success!";
 
+										  fetch_connection_id();
+
 										  // set_charset();
 									  });
 		}
 
-		template <typename _Ty>
-		std::vector<_Ty> make_result(const boost::mysql::results& result)
+		void reset()
+		{
+			XLOG_ERROR() << "mysql connection reset after unfinished execution!";
+
+			statements_.clear();
+
+			connection_id_.store(0, std::memory_order_relaxed);
+
+			mysql_ptr_.reset(new boost::mysql::tcp_ssl_connection(io_service_, ssl_ctx_));
+
+			boost::mysql::error_code ec;
+
+			boost::mysql::diagnostics diag{};
+
+			mysql_ptr_->connect(*endpoint_.begin(), *params_, ec, diag);
+
+			if (ec)
+			{
+				XLOG_ERROR() << "mysql reconnect error! " << ec.what();
+				return;
+			}
+
+			boost::mysql::results result{};
+
+			mysql_ptr_->query("select connection_id()", result, ec, diag);
+
+			if (!ec && !result.rows().empty())
+				connection_id_.store(cast<std::uint64_t>(result.rows()[0][0]), std::memory_order_relaxed);
+		}
+
+		static bool is_server_error(const boost::mysql::error_code& ec)
+		{
+			return ec.category() == boost::mysql::get_common_server_category() ||
+				   ec.category() == boost::mysql::get_mysql_server_category() ||
+				   ec.category() == boost::mysql::get_mariadb_server_category();
+		}
+
+		void fetch_connection_id()
+		{
+			mysql_ptr_->async_query("select connection_id()", id_result_,
+									[this](const boost::mysql::error_code& ec)
+									{
+										if (ec || id_result_.rows().empty())
+										{
+											XLOG_ERROR() << "mysql connection id error! " << ec.what();
+
+											set_ready();
+
+											return;
+										}
+
+										connection_id_.store(cast<std::uint64_t>(id_result_.rows()[0][0]),
+															 std::memory_order_relaxed);
+
+										set_ready();
+									});
+		}
+
+		void set_ready()
+		{
+			ready_.store(true, std::memory_order_release);
+
+			ready_.notify_all();
+		}
+
+		void close_statements()
+		{
+			boost::mysql::error_code ec;
+
+			boost::mysql::diagnostics diag{};
+
+			for (auto& [sql, stmt] : statements_)
+			{
+				mysql_ptr_->close_statement(stmt, ec, diag);
+
+				if (ec)
+				{
+					XLOG_ERROR() << "close statement failed! " << ec.what();
+				}
+			}
+
+			statements_.clear();
+		}
+
+		boost::mysql::statement prepare(const std::string& sql, boost::mysql::error_code& ec,
+										boost::mysql::diagnostics& diag)
+		{
+			auto iter = statements_.find(sql);
+
+			if (iter != statements_.end())
+				return iter->second;
+
+			if (statements_.size() >= statement_capacity)
+				close_statements();
+
+			auto stmt = mysql_ptr_->prepare_statement(sql, ec, diag);
+
+			if (!ec)
+				statements_.emplace(sql, stmt);
+
+			return stmt;
+		}
+
+		void run(const std::string& sql, const std::vector<boost::mysql::field_view>& params,
+				 boost::mysql::results& result, boost::mysql::error_code& ec, boost::mysql::diagnostics& diag)
+		{
+			scoped_span span(span_name::execute);
+
+			if (params.empty())
+			{
+				mysql_ptr_->query(sql, result, ec, diag);
+			}
+			else
+			{
+				auto stmt = prepare(sql, ec, diag);
+
+				if (!ec)
+					mysql_ptr_->execute(stmt.bind(params.begin(), params.end()), result, ec, diag);
+			}
+
+			span.set_error(ec);
+		}
+
+		template <typename _Ty, string_literal... args>
+		std::vector<_Ty> make_result(const boost::mysql::results& result, trace_span* parent = scoped_span::current())
 		{
 			std::vector<_Ty> results{};
 
 			if (!result.has_value())
 				return results;
 
-			for (auto column : result.rows())
+			scoped_span span(span_name::decode, parent);
+
+			span.set_attribute("db.rows", result.rows().size());
+
+			results.reserve(result.rows().size());
+
+			if constexpr (sizeof...(args) == 0 && named_fields_t<_Ty>)
+			{
+				const auto index = column_map<_Ty>::get(result.meta());
+
+				for (auto column : result.rows())
+				{
+					results.push_back(to_struct<_Ty>(column, index));
+				}
+			}
+			else
 			{
-				results.push_back(to_struct<_Ty>(column));
+				for (auto column : result.rows())
+				{
+					results.push_back(to_struct<_Ty, args...>(column));
+				}
 			}
 
 			return results;
@@ -165,5 +659,17 @@ namespace aquarius
 		boost::asio::ip::tcp::resolver::results_type endpoint_;
 
 		std::shared_ptr<boost::mysql::handshake_params> params_;
+
+		std::unordered_map<std::string, boost::mysql::statement> statements_;
+
+		std::uint64_t last_bytes_ = 0;
+
+		bool count_bytes_ = false;
+
+		boost::mysql::results id_result_;
+
+		std::atomic<std::uint64_t> connection_id_{ 0 };
+
+		std::atomic<bool> ready_{ false };
 	};
 } // namespace aquarius
\ No newline at end of file
@@ -0,0 +1,171 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <boost/mysql.hpp>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace aquarius
+{
+	template <typename _Ty>
+	class pmr_result
+	{
+		struct storage
+		{
+			explicit storage(std::size_t bytes)
+				: resource(bytes == 0 ? 1 : bytes)
+				, rows(&resource)
+			{}
+
+			std::pmr::monotonic_buffer_resource resource;
+
+			std::pmr::vector<_Ty> rows;
+		};
+
+	public:
+		using value_type = _Ty;
+
+		using const_iterator = typename std::pmr::vector<_Ty>::const_iterator;
+
+	public:
+		explicit pmr_result(std::size_t rows = 0, std::size_t bytes = 0)
+			: storage_(std::make_unique<storage>(rows * sizeof(_Ty) + bytes))
+		{
+			storage_->rows.reserve(rows);
+		}
+
+		~pmr_result() = default;
+
+		pmr_result(pmr_result&&) noexcept = default;
+
+		pmr_result& operator=(pmr_result&&) noexcept = default;
+
+	public:
+		std::size_t size() const
+		{
+			return storage_ ? storage_->rows.size() : 0;
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		const _Ty& operator[](std::size_t pos) const
+		{
+			return storage_->rows[pos];
+		}
+
+		const_iterator begin() const
+		{
+			return storage_ ? storage_->rows.begin() : const_iterator{};
+		}
+
+		const_iterator end() const
+		{
+			return storage_ ? storage_->rows.end() : const_iterator{};
+		}
+
+		std::pmr::memory_resource* resource()
+		{
+			return &get_storage().resource;
+		}
+
+		template <typename... _Args>
+		_Ty& emplace_back(_Args&&... args)
+		{
+			return get_storage().rows.emplace_back(std::forward<_Args>(args)...);
+		}
+
+	private:
+		storage& get_storage()
+		{
+			if (!storage_)
+				storage_ = std::make_unique<storage>(0);
+
+			return *storage_;
+		}
+
+	private:
+		std::unique_ptr<storage> storage_;
+	};
+
+	template <typename _Ty>
+	auto cast(const boost::mysql::field_view& field, std::pmr::memory_resource* resource)
+	{
+		using type = std::remove_cvref_t<_Ty>;
+
+		if constexpr (std::same_as<type, std::pmr::string>)
+		{
+			if (field.is_string())
+				return type(field.as_string(), resource);
+
+			std::stringstream ss{};
+			ss << field;
+
+			return type(ss.str(), resource);
+		}
+		else
+		{
+			return cast<_Ty>(field);
+		}
+	}
+
+	template <typename _Ty, typename _Row>
+	auto cast_column(const _Row& row, std::size_t column, std::pmr::memory_resource* resource)
+	{
+		if (column >= row.size())
+			return std::remove_cvref_t<_Ty>{};
+
+		return cast<_Ty>(row[column], resource);
+	}
+
+	template <typename T, typename _Row, std::size_t N, std::size_t... I>
+	auto to_struct_impl(const _Row& row, const std::array<std::size_t, N>& index, std::pmr::memory_resource* resource,
+						std::index_sequence<I...>)
+	{
+		return T{ cast_column<tuple_element_t<I, T>>(row, index[I], resource)... };
+	}
+
+	template <typename _Row, std::size_t N>
+	std::size_t pmr_string_bytes(const _Row& row, const std::array<std::size_t, N>& index)
+	{
+		std::size_t bytes = 0;
+
+		for (auto column : index)
+		{
+			if (column < row.size() && row[column].is_string())
+				bytes += row[column].as_string().size() + 1;
+		}
+
+		return bytes;
+	}
+
+	template <typename _Ty, typename _Rows, std::size_t N>
+	pmr_result<_Ty> make_pmr_result(const _Rows& rows, const std::array<std::size_t, N>& index)
+	{
+		std::size_t bytes = 0;
+
+		for (const auto& row : rows)
+		{
+			bytes += pmr_string_bytes(row, index);
+		}
+
+		pmr_result<_Ty> result(rows.size(), bytes);
+
+		for (const auto& row : rows)
+		{
+			result.emplace_back(to_struct_impl<_Ty>(row, index, result.resource(), std::make_index_sequence<N>{}));
+		}
+
+		return result;
+	}
+
+	template <typename _Ty, typename _Rows>
+	pmr_result<_Ty> make_pmr_result(const _Rows& rows)
+	{
+		return make_pmr_result<_Ty>(rows, identity_index<_Ty>());
+	}
+} // namespace aquarius
@@ -0,0 +1,299 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	enum class priority_class
+	{
+		interactive,
+		normal,
+		bulk
+	};
+
+	struct priority_options
+	{
+		std::size_t max_connections = 0;
+
+		std::size_t reserved = 1;
+
+		std::size_t bulk_limit = 2;
+	};
+
+	namespace detail
+	{
+		class priority_waiter
+		{
+		public:
+			virtual ~priority_waiter() = default;
+
+		public:
+			virtual void operator()(bool entered) = 0;
+		};
+
+		template <typename _Func>
+		class priority_waiter_impl : public priority_waiter
+		{
+		public:
+			explicit priority_waiter_impl(_Func f)
+				: func_(std::move(f))
+			{}
+
+		public:
+			void operator()(bool entered) override
+			{
+				func_(entered);
+			}
+
+		private:
+			_Func func_;
+		};
+	} // namespace detail
+
+	class scoped_priority
+	{
+	public:
+		explicit scoped_priority(priority_class value)
+			: previous_(current())
+		{
+			current_priority() = value;
+		}
+
+		scoped_priority(const scoped_priority&) = delete;
+
+		scoped_priority& operator=(const scoped_priority&) = delete;
+
+		~scoped_priority()
+		{
+			current_priority() = previous_;
+		}
+
+	public:
+		static priority_class current()
+		{
+			return current_priority();
+		}
+
+	private:
+		static priority_class& current_priority()
+		{
+			thread_local priority_class value = priority_class::normal;
+
+			return value;
+		}
+
+	private:
+		priority_class previous_;
+	};
+
+	class priority_gate
+	{
+		static constexpr std::size_t class_count = 3;
+
+	public:
+		priority_gate() = default;
+
+		~priority_gate() = default;
+
+	public:
+		void configure(priority_options options)
+		{
+			{
+				std::lock_guard lk(mutex_);
+
+				options_ = options;
+
+				enabled_ = true;
+			}
+
+			notify();
+		}
+
+		bool enabled() const
+		{
+			std::lock_guard lk(mutex_);
+
+			return enabled_;
+		}
+
+		bool enter(priority_class value)
+		{
+			std::unique_lock lk(mutex_);
+
+			if (!enabled_)
+				return false;
+
+			auto& waiting = waiting_[index(value)];
+
+			++waiting;
+
+			ready_[index(value)].wait(lk, [&] { return admissible(value); });
+
+			--waiting;
+
+			++in_use_[index(value)];
+
+			return true;
+		}
+
+		template <typename _Func>
+		void async_enter(priority_class value, _Func&& f)
+		{
+			using waiter_type = detail::priority_waiter_impl<std::decay_t<_Func>>;
+
+			auto waiter = std::make_unique<waiter_type>(std::forward<_Func>(f));
+
+			bool entered = false;
+
+			{
+				std::lock_guard lk(mutex_);
+
+				if (enabled_)
+				{
+					auto& pending = pending_[index(value)];
+
+					if (pending.empty() && admissible(value))
+					{
+						++in_use_[index(value)];
+					}
+					else
+					{
+						++waiting_[index(value)];
+
+						pending.push_back(std::move(waiter));
+
+						return;
+					}
+
+					entered = true;
+				}
+			}
+
+			(*waiter)(entered);
+		}
+
+		void lease(const void* key, priority_class value)
+		{
+			std::lock_guard lk(mutex_);
+
+			leases_[key] = value;
+		}
+
+		bool leave(const void* key)
+		{
+			std::lock_guard lk(mutex_);
+
+			auto iter = leases_.find(key);
+
+			if (iter == leases_.end())
+				return false;
+
+			--in_use_[index(iter->second)];
+
+			leases_.erase(iter);
+
+			return true;
+		}
+
+		std::size_t in_use(priority_class value) const
+		{
+			std::lock_guard lk(mutex_);
+
+			return in_use_[index(value)];
+		}
+
+		std::size_t waiting(priority_class value) const
+		{
+			std::lock_guard lk(mutex_);
+
+			return waiting_[index(value)];
+		}
+
+		void notify()
+		{
+			std::vector<std::unique_ptr<detail::priority_waiter>> admitted{};
+
+			{
+				std::lock_guard lk(mutex_);
+
+				for (std::size_t i = 0; i < class_count; ++i)
+				{
+					auto value = static_cast<priority_class>(i);
+
+					auto& pending = pending_[i];
+
+					while (!pending.empty() && admissible(value))
+					{
+						--waiting_[i];
+
+						++in_use_[i];
+
+						admitted.push_back(std::move(pending.front()));
+
+						pending.pop_front();
+					}
+				}
+			}
+
+			for (auto& ready : ready_)
+			{
+				ready.notify_all();
+			}
+
+			for (auto& waiter : admitted)
+			{
+				(*waiter)(true);
+			}
+		}
+
+	private:
+		static std::size_t index(priority_class value)
+		{
+			return static_cast<std::size_t>(value);
+		}
+
+		bool admissible(priority_class value) const
+		{
+			auto total = in_use_[0] + in_use_[1] + in_use_[2];
+
+			auto shared = options_.max_connections > options_.reserved ? options_.max_connections - options_.reserved
+																	   : 0;
+
+			switch (value)
+			{
+			case priority_class::interactive:
+				return total < options_.max_connections;
+			case priority_class::normal:
+				return waiting_[0] == 0 && total < shared;
+			case priority_class::bulk:
+				return waiting_[0] == 0 && waiting_[1] == 0 && total < shared &&
+					   in_use_[2] < options_.bulk_limit;
+			}
+
+			return false;
+		}
+
+	private:
+		mutable std::mutex mutex_;
+
+		bool enabled_ = false;
+
+		priority_options options_;
+
+		std::array<std::size_t, class_count> in_use_{};
+
+		std::array<std::size_t, class_count> waiting_{};
+
+		std::array<std::condition_variable, class_count> ready_;
+
+		std::array<std::deque<std::unique_ptr<detail::priority_waiter>>, class_count> pending_;
+
+		std::unordered_map<const void*, priority_class> leases_;
+	};
+} // namespace aquarius
@@ -1,6 +1,9 @@
 #pragma once
+#include <aquarius/mysql/string_literal.hpp>
 #include <aquarius/type_traits.hpp>
 
+#include <algorithm>
+#include <climits>
 #include <string_view>
 
 using namespace std::string_view_literals;
@@ -8,46 +11,27 @@ using namespace std::string_view_literals;
 namespace
 {
 	template <typename _Ty, std::size_t N>
-	constexpr std::size_t find_n_of()
+	constexpr auto split()
 	{
-		std::size_t pos = 0;
 		constexpr auto member = _Ty::member_str();
 
-		int i = N + 1;
-		for (; i > 0; i--)
-		{
-			pos = member.find_first_of(";", pos + 1);
-		}
+		std::array<std::string_view, N> result{};
 
-		return pos;
-	}
+		std::size_t begin = 0;
 
-	template <typename _Ty, std::size_t _Index>
-	constexpr auto get()
-	{
-		constexpr auto member_info = _Ty::member_str();
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			auto end = member.find_first_of(";", begin);
 
-		constexpr std::size_t pos = member_info.find_first_of(";", find_n_of<_Ty, _Index>());
+			auto s = member.substr(begin, end - begin);
 
-		constexpr std::string_view s =
-			member_info.substr(find_n_of<_Ty, _Index - 1>() + 1, pos - find_n_of<_Ty, _Index - 1>() - 1);
+			result[i] = s.substr(s.rfind(" ") + 1);
 
-		constexpr std::string_view result = s.substr(s.rfind(" ") + 1);
+			begin = end + 1;
+		}
 
 		return result;
 	}
-
-	template <typename _Ty, std::size_t... I>
-	constexpr auto split_impl(std::index_sequence<I...>)
-	{
-		return std::array{ get<_Ty, I>()... };
-	}
-
-	template <typename _Ty, std::size_t N, typename Indices = std::make_index_sequence<N>>
-	constexpr auto split()
-	{
-		return split_impl<_Ty>(Indices{});
-	}
 }
 
 namespace aquarius
@@ -117,7 +101,7 @@ namespace aquarius
 		{
 			using type = std::remove_cv_t<_Ty>;
 
-			constexpr std::size_t max_fields_count = sizeof(type) * CHAR_BIT;
+			constexpr std::size_t max_fields_count = std::min<std::size_t>(sizeof(type) * CHAR_BIT, 129);
 
 			constexpr std::size_t result =
 				detail::template detect_fields_count_dispatch<type>(size_t_<max_fields_count>{});
@@ -368,6 +352,311 @@ namespace aquarius
 			return std::forward_as_tuple(a, b, c, d, e, f, g, h, j, k, l, m, n, p, q, r, s, t, u, v, w, x, y, z, A, B,
 										 C, D, E, F, G, H);
 		}
+
+#define AQUARIUS_REFLECT_FIELDS_32	\
+	f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,	\
+	f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31
+#define AQUARIUS_REFLECT_FIELDS_33 AQUARIUS_REFLECT_FIELDS_32, f32
+#define AQUARIUS_REFLECT_FIELDS_34 AQUARIUS_REFLECT_FIELDS_33, f33
+#define AQUARIUS_REFLECT_FIELDS_35 AQUARIUS_REFLECT_FIELDS_34, f34
+#define AQUARIUS_REFLECT_FIELDS_36 AQUARIUS_REFLECT_FIELDS_35, f35
+#define AQUARIUS_REFLECT_FIELDS_37 AQUARIUS_REFLECT_FIELDS_36, f36
+#define AQUARIUS_REFLECT_FIELDS_38 AQUARIUS_REFLECT_FIELDS_37, f37
+#define AQUARIUS_REFLECT_FIELDS_39 AQUARIUS_REFLECT_FIELDS_38, f38
+#define AQUARIUS_REFLECT_FIELDS_40 AQUARIUS_REFLECT_FIELDS_39, f39
+#define AQUARIUS_REFLECT_FIELDS_41 AQUARIUS_REFLECT_FIELDS_40, f40
+#define AQUARIUS_REFLECT_FIELDS_42 AQUARIUS_REFLECT_FIELDS_41, f41
+#define AQUARIUS_REFLECT_FIELDS_43 AQUARIUS_REFLECT_FIELDS_42, f42
+#define AQUARIUS_REFLECT_FIELDS_44 AQUARIUS_REFLECT_FIELDS_43, f43
+#define AQUARIUS_REFLECT_FIELDS_45 AQUARIUS_REFLECT_FIELDS_44, f44
+#define AQUARIUS_REFLECT_FIELDS_46 AQUARIUS_REFLECT_FIELDS_45, f45
+#define AQUARIUS_REFLECT_FIELDS_47 AQUARIUS_REFLECT_FIELDS_46, f46
+#define AQUARIUS_REFLECT_FIELDS_48 AQUARIUS_REFLECT_FIELDS_47, f47
+#define AQUARIUS_REFLECT_FIELDS_49 AQUARIUS_REFLECT_FIELDS_48, f48
+#define AQUARIUS_REFLECT_FIELDS_50 AQUARIUS_REFLECT_FIELDS_49, f49
+#define AQUARIUS_REFLECT_FIELDS_51 AQUARIUS_REFLECT_FIELDS_50, f50
+#define AQUARIUS_REFLECT_FIELDS_52 AQUARIUS_REFLECT_FIELDS_51, f51
+#define AQUARIUS_REFLECT_FIELDS_53 AQUARIUS_REFLECT_FIELDS_52, f52
+#define AQUARIUS_REFLECT_FIELDS_54 AQUARIUS_REFLECT_FIELDS_53, f53
+#define AQUARIUS_REFLECT_FIELDS_55 AQUARIUS_REFLECT_FIELDS_54, f54
+#define AQUARIUS_REFLECT_FIELDS_56 AQUARIUS_REFLECT_FIELDS_55, f55
+#define AQUARIUS_REFLECT_FIELDS_57 AQUARIUS_REFLECT_FIELDS_56, f56
+#define AQUARIUS_REFLECT_FIELDS_58 AQUARIUS_REFLECT_FIELDS_57, f57
+#define AQUARIUS_REFLECT_FIELDS_59 AQUARIUS_REFLECT_FIELDS_58, f58
+#define AQUARIUS_REFLECT_FIELDS_60 AQUARIUS_REFLECT_FIELDS_59, f59
+#define AQUARIUS_REFLECT_FIELDS_61 AQUARIUS_REFLECT_FIELDS_60, f60
+#define AQUARIUS_REFLECT_FIELDS_62 AQUARIUS_REFLECT_FIELDS_61, f61
+#define AQUARIUS_REFLECT_FIELDS_63 AQUARIUS_REFLECT_FIELDS_62, f62
+#define AQUARIUS_REFLECT_FIELDS_64 AQUARIUS_REFLECT_FIELDS_63, f63
+#define AQUARIUS_REFLECT_FIELDS_65 AQUARIUS_REFLECT_FIELDS_64, f64
+#define AQUARIUS_REFLECT_FIELDS_66 AQUARIUS_REFLECT_FIELDS_65, f65
+#define AQUARIUS_REFLECT_FIELDS_67 AQUARIUS_REFLECT_FIELDS_66, f66
+#define AQUARIUS_REFLECT_FIELDS_68 AQUARIUS_REFLECT_FIELDS_67, f67
+#define AQUARIUS_REFLECT_FIELDS_69 AQUARIUS_REFLECT_FIELDS_68, f68
+#define AQUARIUS_REFLECT_FIELDS_70 AQUARIUS_REFLECT_FIELDS_69, f69
+#define AQUARIUS_REFLECT_FIELDS_71 AQUARIUS_REFLECT_FIELDS_70, f70
+#define AQUARIUS_REFLECT_FIELDS_72 AQUARIUS_REFLECT_FIELDS_71, f71
+#define AQUARIUS_REFLECT_FIELDS_73 AQUARIUS_REFLECT_FIELDS_72, f72
+#define AQUARIUS_REFLECT_FIELDS_74 AQUARIUS_REFLECT_FIELDS_73, f73
+#define AQUARIUS_REFLECT_FIELDS_75 AQUARIUS_REFLECT_FIELDS_74, f74
+#define AQUARIUS_REFLECT_FIELDS_76 AQUARIUS_REFLECT_FIELDS_75, f75
+#define AQUARIUS_REFLECT_FIELDS_77 AQUARIUS_REFLECT_FIELDS_76, f76
+#define AQUARIUS_REFLECT_FIELDS_78 AQUARIUS_REFLECT_FIELDS_77, f77
+#define AQUARIUS_REFLECT_FIELDS_79 AQUARIUS_REFLECT_FIELDS_78, f78
+#define AQUARIUS_REFLECT_FIELDS_80 AQUARIUS_REFLECT_FIELDS_79, f79
+#define AQUARIUS_REFLECT_FIELDS_81 AQUARIUS_REFLECT_FIELDS_80, f80
+#define AQUARIUS_REFLECT_FIELDS_82 AQUARIUS_REFLECT_FIELDS_81, f81
+#define AQUARIUS_REFLECT_FIELDS_83 AQUARIUS_REFLECT_FIELDS_82, f82
+#define AQUARIUS_REFLECT_FIELDS_84 AQUARIUS_REFLECT_FIELDS_83, f83
+#define AQUARIUS_REFLECT_FIELDS_85 AQUARIUS_REFLECT_FIELDS_84, f84
+#define AQUARIUS_REFLECT_FIELDS_86 AQUARIUS_REFLECT_FIELDS_85, f85
+#define AQUARIUS_REFLECT_FIELDS_87 AQUARIUS_REFLECT_FIELDS_86, f86
+#define AQUARIUS_REFLECT_FIELDS_88 AQUARIUS_REFLECT_FIELDS_87, f87
+#define AQUARIUS_REFLECT_FIELDS_89 AQUARIUS_REFLECT_FIELDS_88, f88
+#define AQUARIUS_REFLECT_FIELDS_90 AQUARIUS_REFLECT_FIELDS_89, f89
+#define AQUARIUS_REFLECT_FIELDS_91 AQUARIUS_REFLECT_FIELDS_90, f90
+#define AQUARIUS_REFLECT_FIELDS_92 AQUARIUS_REFLECT_FIELDS_91, f91
+#define AQUARIUS_REFLECT_FIELDS_93 AQUARIUS_REFLECT_FIELDS_92, f92
+#define AQUARIUS_REFLECT_FIELDS_94 AQUARIUS_REFLECT_FIELDS_93, f93
+#define AQUARIUS_REFLECT_FIELDS_95 AQUARIUS_REFLECT_FIELDS_94, f94
+#define AQUARIUS_REFLECT_FIELDS_96 AQUARIUS_REFLECT_FIELDS_95, f95
+#define AQUARIUS_REFLECT_FIELDS_97 AQUARIUS_REFLECT_FIELDS_96, f96
+#define AQUARIUS_REFLECT_FIELDS_98 AQUARIUS_REFLECT_FIELDS_97, f97
+#define AQUARIUS_REFLECT_FIELDS_99 AQUARIUS_REFLECT_FIELDS_98, f98
+#define AQUARIUS_REFLECT_FIELDS_100 AQUARIUS_REFLECT_FIELDS_99, f99
+#define AQUARIUS_REFLECT_FIELDS_101 AQUARIUS_REFLECT_FIELDS_100, f100
+#define AQUARIUS_REFLECT_FIELDS_102 AQUARIUS_REFLECT_FIELDS_101, f101
+#define AQUARIUS_REFLECT_FIELDS_103 AQUARIUS_REFLECT_FIELDS_102, f102
+#define AQUARIUS_REFLECT_FIELDS_104 AQUARIUS_REFLECT_FIELDS_103, f103
+#define AQUARIUS_REFLECT_FIELDS_105 AQUARIUS_REFLECT_FIELDS_104, f104
+#define AQUARIUS_REFLECT_FIELDS_106 AQUARIUS_REFLECT_FIELDS_105, f105
+#define AQUARIUS_REFLECT_FIELDS_107 AQUARIUS_REFLECT_FIELDS_106, f106
+#define AQUARIUS_REFLECT_FIELDS_108 AQUARIUS_REFLECT_FIELDS_107, f107
+#define AQUARIUS_REFLECT_FIELDS_109 AQUARIUS_REFLECT_FIELDS_108, f108
+#define AQUARIUS_REFLECT_FIELDS_110 AQUARIUS_REFLECT_FIELDS_109, f109
+#define AQUARIUS_REFLECT_FIELDS_111 AQUARIUS_REFLECT_FIELDS_110, f110
+#define AQUARIUS_REFLECT_FIELDS_112 AQUARIUS_REFLECT_FIELDS_111, f111
+#define AQUARIUS_REFLECT_FIELDS_113 AQUARIUS_REFLECT_FIELDS_112, f112
+#define AQUARIUS_REFLECT_FIELDS_114 AQUARIUS_REFLECT_FIELDS_113, f113
+#define AQUARIUS_REFLECT_FIELDS_115 AQUARIUS_REFLECT_FIELDS_114, f114
+#define AQUARIUS_REFLECT_FIELDS_116 AQUARIUS_REFLECT_FIELDS_115, f115
+#define AQUARIUS_REFLECT_FIELDS_117 AQUARIUS_REFLECT_FIELDS_116, f116
+#define AQUARIUS_REFLECT_FIELDS_118 AQUARIUS_REFLECT_FIELDS_117, f117
+#define AQUARIUS_REFLECT_FIELDS_119 AQUARIUS_REFLECT_FIELDS_118, f118
+#define AQUARIUS_REFLECT_FIELDS_120 AQUARIUS_REFLECT_FIELDS_119, f119
+#define AQUARIUS_REFLECT_FIELDS_121 AQUARIUS_REFLECT_FIELDS_120, f120
+#define AQUARIUS_REFLECT_FIELDS_122 AQUARIUS_REFLECT_FIELDS_121, f121
+#define AQUARIUS_REFLECT_FIELDS_123 AQUARIUS_REFLECT_FIELDS_122, f122
+#define AQUARIUS_REFLECT_FIELDS_124 AQUARIUS_REFLECT_FIELDS_123, f123
+#define AQUARIUS_REFLECT_FIELDS_125 AQUARIUS_REFLECT_FIELDS_124, f124
+#define AQUARIUS_REFLECT_FIELDS_126 AQUARIUS_REFLECT_FIELDS_125, f125
+#define AQUARIUS_REFLECT_FIELDS_127 AQUARIUS_REFLECT_FIELDS_126, f126
+#define AQUARIUS_REFLECT_FIELDS_128 AQUARIUS_REFLECT_FIELDS_127, f127
+
+#define AQUARIUS_REFLECT_MAKE_TUPLE(N)	\
+		template <typename _Ty>	\
+		constexpr auto make_tuple(_Ty&& val, size_t_<N>) noexcept	\
+		{	\
+			auto&& [AQUARIUS_REFLECT_FIELDS_##N] = val;	\
+			return std::forward_as_tuple(AQUARIUS_REFLECT_FIELDS_##N);	\
+		}
+
+		AQUARIUS_REFLECT_MAKE_TUPLE(33)
+		AQUARIUS_REFLECT_MAKE_TUPLE(34)
+		AQUARIUS_REFLECT_MAKE_TUPLE(35)
+		AQUARIUS_REFLECT_MAKE_TUPLE(36)
+		AQUARIUS_REFLECT_MAKE_TUPLE(37)
+		AQUARIUS_REFLECT_MAKE_TUPLE(38)
+		AQUARIUS_REFLECT_MAKE_TUPLE(39)
+		AQUARIUS_REFLECT_MAKE_TUPLE(40)
+		AQUARIUS_REFLECT_MAKE_TUPLE(41)
+		AQUARIUS_REFLECT_MAKE_TUPLE(42)
+		AQUARIUS_REFLECT_MAKE_TUPLE(43)
+		AQUARIUS_REFLECT_MAKE_TUPLE(44)
+		AQUARIUS_REFLECT_MAKE_TUPLE(45)
+		AQUARIUS_REFLECT_MAKE_TUPLE(46)
+		AQUARIUS_REFLECT_MAKE_TUPLE(47)
+		AQUARIUS_REFLECT_MAKE_TUPLE(48)
+		AQUARIUS_REFLECT_MAKE_TUPLE(49)
+		AQUARIUS_REFLECT_MAKE_TUPLE(50)
+		AQUARIUS_REFLECT_MAKE_TUPLE(51)
+		AQUARIUS_REFLECT_MAKE_TUPLE(52)
+		AQUARIUS_REFLECT_MAKE_TUPLE(53)
+		AQUARIUS_REFLECT_MAKE_TUPLE(54)
+		AQUARIUS_REFLECT_MAKE_TUPLE(55)
+		AQUARIUS_REFLECT_MAKE_TUPLE(56)
+		AQUARIUS_REFLECT_MAKE_TUPLE(57)
+		AQUARIUS_REFLECT_MAKE_TUPLE(58)
+		AQUARIUS_REFLECT_MAKE_TUPLE(59)
+		AQUARIUS_REFLECT_MAKE_TUPLE(60)
+		AQUARIUS_REFLECT_MAKE_TUPLE(61)
+		AQUARIUS_REFLECT_MAKE_TUPLE(62)
+		AQUARIUS_REFLECT_MAKE_TUPLE(63)
+		AQUARIUS_REFLECT_MAKE_TUPLE(64)
+		AQUARIUS_REFLECT_MAKE_TUPLE(65)
+		AQUARIUS_REFLECT_MAKE_TUPLE(66)
+		AQUARIUS_REFLECT_MAKE_TUPLE(67)
+		AQUARIUS_REFLECT_MAKE_TUPLE(68)
+		AQUARIUS_REFLECT_MAKE_TUPLE(69)
+		AQUARIUS_REFLECT_MAKE_TUPLE(70)
+		AQUARIUS_REFLECT_MAKE_TUPLE(71)
+		AQUARIUS_REFLECT_MAKE_TUPLE(72)
+		AQUARIUS_REFLECT_MAKE_TUPLE(73)
+		AQUARIUS_REFLECT_MAKE_TUPLE(74)
+		AQUARIUS_REFLECT_MAKE_TUPLE(75)
+		AQUARIUS_REFLECT_MAKE_TUPLE(76)
+		AQUARIUS_REFLECT_MAKE_TUPLE(77)
+		AQUARIUS_REFLECT_MAKE_TUPLE(78)
+		AQUARIUS_REFLECT_MAKE_TUPLE(79)
+		AQUARIUS_REFLECT_MAKE_TUPLE(80)
+		AQUARIUS_REFLECT_MAKE_TUPLE(81)
+		AQUARIUS_REFLECT_MAKE_TUPLE(82)
+		AQUARIUS_REFLECT_MAKE_TUPLE(83)
+		AQUARIUS_REFLECT_MAKE_TUPLE(84)
+		AQUARIUS_REFLECT_MAKE_TUPLE(85)
+		AQUARIUS_REFLECT_MAKE_TUPLE(86)
+		AQUARIUS_REFLECT_MAKE_TUPLE(87)
+		AQUARIUS_REFLECT_MAKE_TUPLE(88)
+		AQUARIUS_REFLECT_MAKE_TUPLE(89)
+		AQUARIUS_REFLECT_MAKE_TUPLE(90)
+		AQUARIUS_REFLECT_MAKE_TUPLE(91)
+		AQUARIUS_REFLECT_MAKE_TUPLE(92)
+		AQUARIUS_REFLECT_MAKE_TUPLE(93)
+		AQUARIUS_REFLECT_MAKE_TUPLE(94)
+		AQUARIUS_REFLECT_MAKE_TUPLE(95)
+		AQUARIUS_REFLECT_MAKE_TUPLE(96)
+		AQUARIUS_REFLECT_MAKE_TUPLE(97)
+		AQUARIUS_REFLECT_MAKE_TUPLE(98)
+		AQUARIUS_REFLECT_MAKE_TUPLE(99)
+		AQUARIUS_REFLECT_MAKE_TUPLE(100)
+		AQUARIUS_REFLECT_MAKE_TUPLE(101)
+		AQUARIUS_REFLECT_MAKE_TUPLE(102)
+		AQUARIUS_REFLECT_MAKE_TUPLE(103)
+		AQUARIUS_REFLECT_MAKE_TUPLE(104)
+		AQUARIUS_REFLECT_MAKE_TUPLE(105)
+		AQUARIUS_REFLECT_MAKE_TUPLE(106)
+		AQUARIUS_REFLECT_MAKE_TUPLE(107)
+		AQUARIUS_REFLECT_MAKE_TUPLE(108)
+		AQUARIUS_REFLECT_MAKE_TUPLE(109)
+		AQUARIUS_REFLECT_MAKE_TUPLE(110)
+		AQUARIUS_REFLECT_MAKE_TUPLE(111)
+		AQUARIUS_REFLECT_MAKE_TUPLE(112)
+		AQUARIUS_REFLECT_MAKE_TUPLE(113)
+		AQUARIUS_REFLECT_MAKE_TUPLE(114)
+		AQUARIUS_REFLECT_MAKE_TUPLE(115)
+		AQUARIUS_REFLECT_MAKE_TUPLE(116)
+		AQUARIUS_REFLECT_MAKE_TUPLE(117)
+		AQUARIUS_REFLECT_MAKE_TUPLE(118)
+		AQUARIUS_REFLECT_MAKE_TUPLE(119)
+		AQUARIUS_REFLECT_MAKE_TUPLE(120)
+		AQUARIUS_REFLECT_MAKE_TUPLE(121)
+		AQUARIUS_REFLECT_MAKE_TUPLE(122)
+		AQUARIUS_REFLECT_MAKE_TUPLE(123)
+		AQUARIUS_REFLECT_MAKE_TUPLE(124)
+		AQUARIUS_REFLECT_MAKE_TUPLE(125)
+		AQUARIUS_REFLECT_MAKE_TUPLE(126)
+		AQUARIUS_REFLECT_MAKE_TUPLE(127)
+		AQUARIUS_REFLECT_MAKE_TUPLE(128)
+
+#undef AQUARIUS_REFLECT_MAKE_TUPLE
+
+#undef AQUARIUS_REFLECT_FIELDS_32
+#undef AQUARIUS_REFLECT_FIELDS_33
+#undef AQUARIUS_REFLECT_FIELDS_34
+#undef AQUARIUS_REFLECT_FIELDS_35
+#undef AQUARIUS_REFLECT_FIELDS_36
+#undef AQUARIUS_REFLECT_FIELDS_37
+#undef AQUARIUS_REFLECT_FIELDS_38
+#undef AQUARIUS_REFLECT_FIELDS_39
+#undef AQUARIUS_REFLECT_FIELDS_40
+#undef AQUARIUS_REFLECT_FIELDS_41
+#undef AQUARIUS_REFLECT_FIELDS_42
+#undef AQUARIUS_REFLECT_FIELDS_43
+#undef AQUARIUS_REFLECT_FIELDS_44
+#undef AQUARIUS_REFLECT_FIELDS_45
+#undef AQUARIUS_REFLECT_FIELDS_46
+#undef AQUARIUS_REFLECT_FIELDS_47
+#undef AQUARIUS_REFLECT_FIELDS_48
+#undef AQUARIUS_REFLECT_FIELDS_49
+#undef AQUARIUS_REFLECT_FIELDS_50
+#undef AQUARIUS_REFLECT_FIELDS_51
+#undef AQUARIUS_REFLECT_FIELDS_52
+#undef AQUARIUS_REFLECT_FIELDS_53
+#undef AQUARIUS_REFLECT_FIELDS_54
+#undef AQUARIUS_REFLECT_FIELDS_55
+#undef AQUARIUS_REFLECT_FIELDS_56
+#undef AQUARIUS_REFLECT_FIELDS_57
+#undef AQUARIUS_REFLECT_FIELDS_58
+#undef AQUARIUS_REFLECT_FIELDS_59
+#undef AQUARIUS_REFLECT_FIELDS_60
+#undef AQUARIUS_REFLECT_FIELDS_61
+#undef AQUARIUS_REFLECT_FIELDS_62
+#undef AQUARIUS_REFLECT_FIELDS_63
+#undef AQUARIUS_REFLECT_FIELDS_64
+#undef AQUARIUS_REFLECT_FIELDS_65
+#undef AQUARIUS_REFLECT_FIELDS_66
+#undef AQUARIUS_REFLECT_FIELDS_67
+#undef AQUARIUS_REFLECT_FIELDS_68
+#undef AQUARIUS_REFLECT_FIELDS_69
+#undef AQUARIUS_REFLECT_FIELDS_70
+#undef AQUARIUS_REFLECT_FIELDS_71
+#undef AQUARIUS_REFLECT_FIELDS_72
+#undef AQUARIUS_REFLECT_FIELDS_73
+#undef AQUARIUS_REFLECT_FIELDS_74
+#undef AQUARIUS_REFLECT_FIELDS_75
+#undef AQUARIUS_REFLECT_FIELDS_76
+#undef AQUARIUS_REFLECT_FIELDS_77
+#undef AQUARIUS_REFLECT_FIELDS_78
+#undef AQUARIUS_REFLECT_FIELDS_79
+#undef AQUARIUS_REFLECT_FIELDS_80
+#undef AQUARIUS_REFLECT_FIELDS_81
+#undef AQUARIUS_REFLECT_FIELDS_82
+#undef AQUARIUS_REFLECT_FIELDS_83
+#undef AQUARIUS_REFLECT_FIELDS_84
+#undef AQUARIUS_REFLECT_FIELDS_85
+#undef AQUARIUS_REFLECT_FIELDS_86
+#undef AQUARIUS_REFLECT_FIELDS_87
+#undef AQUARIUS_REFLECT_FIELDS_88
+#undef AQUARIUS_REFLECT_FIELDS_89
+#undef AQUARIUS_REFLECT_FIELDS_90
+#undef AQUARIUS_REFLECT_FIELDS_91
+#undef AQUARIUS_REFLECT_FIELDS_92
+#undef AQUARIUS_REFLECT_FIELDS_93
+#undef AQUARIUS_REFLECT_FIELDS_94
+#undef AQUARIUS_REFLECT_FIELDS_95
+#undef AQUARIUS_REFLECT_FIELDS_96
+#undef AQUARIUS_REFLECT_FIELDS_97
+#undef AQUARIUS_REFLECT_FIELDS_98
+#undef AQUARIUS_REFLECT_FIELDS_99
+#undef AQUARIUS_REFLECT_FIELDS_100
+#undef AQUARIUS_REFLECT_FIELDS_101
+#undef AQUARIUS_REFLECT_FIELDS_102
+#undef AQUARIUS_REFLECT_FIELDS_103
+#undef AQUARIUS_REFLECT_FIELDS_104
+#undef AQUARIUS_REFLECT_FIELDS_105
+#undef AQUARIUS_REFLECT_FIELDS_106
+#undef AQUARIUS_REFLECT_FIELDS_107
+#undef AQUARIUS_REFLECT_FIELDS_108
+#undef AQUARIUS_REFLECT_FIELDS_109
+#undef AQUARIUS_REFLECT_FIELDS_110
+#undef AQUARIUS_REFLECT_FIELDS_111
+#undef AQUARIUS_REFLECT_FIELDS_112
+#undef AQUARIUS_REFLECT_FIELDS_113
+#undef AQUARIUS_REFLECT_FIELDS_114
+#undef AQUARIUS_REFLECT_FIELDS_115
+#undef AQUARIUS_REFLECT_FIELDS_116
+#undef AQUARIUS_REFLECT_FIELDS_117
+#undef AQUARIUS_REFLECT_FIELDS_118
+#undef AQUARIUS_REFLECT_FIELDS_119
+#undef AQUARIUS_REFLECT_FIELDS_120
+#undef AQUARIUS_REFLECT_FIELDS_121
+#undef AQUARIUS_REFLECT_FIELDS_122
+#undef AQUARIUS_REFLECT_FIELDS_123
+#undef AQUARIUS_REFLECT_FIELDS_124
+#undef AQUARIUS_REFLECT_FIELDS_125
+#undef AQUARIUS_REFLECT_FIELDS_126
+#undef AQUARIUS_REFLECT_FIELDS_127
+#undef AQUARIUS_REFLECT_FIELDS_128
 	} // namespace detail
 
 	template <typename _Ty>
@@ -425,16 +714,34 @@ namespace aquarius
 #endif
 	}
 
+	template <typename _Ty>
+	constexpr auto tie_fields(_Ty&& val) noexcept
+	{
+		static_assert(aquarius::tuple_size_v<_Ty> <= 128, "reflection supports at most 128 fields!");
+
+		return detail::template make_tuple(val, size_t_<aquarius::tuple_size_v<_Ty>>{});
+	}
+
+	template <typename _Ty>
+	using tie_fields_t = decltype(aquarius::tie_fields(std::declval<_Ty&>()));
+
 	template <std::size_t N, typename _Ty>
 	constexpr auto&& get(_Ty&& val)
 	{
-		return std::get<N>(detail::template make_tuple(val, size_t_<aquarius::tuple_size_v<_Ty>>{}));
+		if constexpr (tuple_t<std::remove_cvref_t<_Ty>>)
+		{
+			return std::get<N>(std::forward<_Ty>(val));
+		}
+		else
+		{
+			return std::get<N>(aquarius::tie_fields(val));
+		}
 	}
 
 	template <std::size_t I, typename _Tuple>
 	struct tuple_element
 	{
-		using type = decltype(aquarius::get<I>(std::declval<_Tuple>()));
+		using type = std::tuple_element_t<I, tie_fields_t<_Tuple>>;
 	};
 
 	template <std::size_t I, typename _Tuple>
@@ -446,6 +753,87 @@ namespace aquarius
 		return std::get<I>(decltype(_Tuple::make_reflect_member())::apply_member());
 	}
 
+	template <typename _Ty>
+	concept reflect_t = requires { std::remove_cvref_t<_Ty>::template make_reflect_member<std::remove_cvref_t<_Ty>>(); };
+
+	namespace detail
+	{
+		template <typename _Ty>
+		struct member_wrapper
+		{
+			const _Ty value;
+		};
+
+		template <typename _Ty>
+		extern const member_wrapper<_Ty> member_object;
+
+		template <auto member>
+		constexpr std::string_view member_signature()
+		{
+#ifndef __linux
+			return __FUNCSIG__;
+#else
+			return __PRETTY_FUNCTION__;
+#endif
+		}
+
+		template <typename _Ty, std::size_t I>
+		constexpr std::string_view member_name()
+		{
+			constexpr auto signature =
+				member_signature<&std::get<I>(aquarius::tie_fields(member_object<_Ty>.value))>();
+
+#ifndef __linux
+			constexpr auto end = signature.rfind(">(void)");
+#else
+			constexpr auto end = signature.find_first_of(";]", signature.find("member = "));
+#endif
+
+			constexpr auto path = signature.substr(0, signature[end - 1] == ')' ? end - 1 : end);
+
+			return path.substr(path.find_last_of(".:>") + 1);
+		}
+
+		template <typename _Ty, std::size_t... I>
+		constexpr auto member_names(std::index_sequence<I...>)
+		{
+			return std::array<std::string_view, sizeof...(I)>{ member_name<_Ty, I>()... };
+		}
+	} // namespace detail
+
+	template <typename _Ty>
+	constexpr auto field_names()
+	{
+		using type = std::remove_cvref_t<_Ty>;
+
+		return detail::member_names<type>(std::make_index_sequence<tuple_size_v<type>>{});
+	}
+
+	template <reflect_t _Ty>
+	constexpr auto field_names()
+	{
+		using type = std::remove_cvref_t<_Ty>;
+
+		return decltype(type::template make_reflect_member<type>())::apply_member();
+	}
+
+	template <typename _Ty>
+	concept named_fields_t =
+		reflect_t<_Ty> || (std::is_aggregate_v<std::remove_cvref_t<_Ty>> && !tuple_t<std::remove_cvref_t<_Ty>>);
+
+	template <typename _Ty, string_literal field>
+	constexpr std::size_t field_index()
+	{
+		constexpr auto names = field_names<_Ty>();
+
+		constexpr auto index =
+			static_cast<std::size_t>(std::find(names.begin(), names.end(), bind_param<field>::value) - names.begin());
+
+		static_assert(index < names.size(), "column name is not a member of the type!");
+
+		return index;
+	}
+
 } // namespace elastic
 
 #define MAKE_REFLECT(...)	\
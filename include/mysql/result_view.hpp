@@ -0,0 +1,203 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/column_map.hpp>
+#include <boost/mysql.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace aquarius
+{
+	template <typename _Ty>
+	struct view_field
+	{
+		using type = _Ty;
+	};
+
+	template <>
+	struct view_field<std::string>
+	{
+		using type = std::string_view;
+	};
+
+	template <typename _Ty>
+	using view_field_t = typename view_field<std::remove_cvref_t<_Ty>>::type;
+
+	template <typename _Ty>
+	auto cast_view(const boost::mysql::field_view& field)
+	{
+		using type = view_field_t<_Ty>;
+
+		if constexpr (std::same_as<type, std::string_view>)
+		{
+			return field.is_string() ? field.as_string() : std::string_view{};
+		}
+		else
+		{
+			return cast<type>(field);
+		}
+	}
+
+	template <typename _Ty>
+	class result_view
+	{
+		static constexpr std::size_t field_count = tuple_size_v<_Ty>;
+
+		using index_type = std::array<std::size_t, field_count>;
+
+		struct state
+		{
+			boost::mysql::results results;
+
+			index_type index;
+		};
+
+	public:
+		class row_proxy
+		{
+		public:
+			row_proxy(std::shared_ptr<const state> owner, std::size_t pos)
+				: owner_(std::move(owner))
+				, row_(owner_->results.rows()[pos])
+			{}
+
+		public:
+			template <std::size_t I>
+			view_field_t<tuple_element_t<I, _Ty>> get() const
+			{
+				auto& index = owner_->index;
+
+				if (index[I] >= row_.size())
+					return {};
+
+				return cast_view<tuple_element_t<I, _Ty>>(row_[index[I]]);
+			}
+
+			template <string_literal field>
+			auto get() const
+			{
+				return get<field_index<_Ty, field>()>();
+			}
+
+			_Ty to_struct() const
+			{
+				return aquarius::to_struct<_Ty>(row_, owner_->index);
+			}
+
+		private:
+			std::shared_ptr<const state> owner_;
+
+			boost::mysql::row_view row_;
+		};
+
+		class const_iterator
+		{
+		public:
+			using iterator_concept = std::forward_iterator_tag;
+
+			using iterator_category = std::input_iterator_tag;
+
+			using value_type = row_proxy;
+
+			using difference_type = std::ptrdiff_t;
+
+			using reference = row_proxy;
+
+			using pointer = void;
+
+		public:
+			const_iterator() = default;
+
+			const_iterator(std::shared_ptr<const state> owner, std::size_t pos)
+				: owner_(std::move(owner))
+				, pos_(pos)
+			{}
+
+		public:
+			row_proxy operator*() const
+			{
+				return row_proxy(owner_, pos_);
+			}
+
+			const_iterator& operator++()
+			{
+				++pos_;
+
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				auto result = *this;
+
+				++pos_;
+
+				return result;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return owner_ == other.owner_ && pos_ == other.pos_;
+			}
+
+		private:
+			std::shared_ptr<const state> owner_;
+
+			std::size_t pos_ = 0;
+		};
+
+	public:
+		result_view()
+			: state_(std::make_shared<state>())
+		{
+			state_->index = identity_index<_Ty>();
+		}
+
+		~result_view() = default;
+
+	public:
+		boost::mysql::results& results()
+		{
+			return state_->results;
+		}
+
+		void map_columns()
+		{
+			if constexpr (named_fields_t<_Ty>)
+			{
+				if (state_->results.has_value())
+					state_->index = column_map<_Ty>::get(state_->results.meta());
+			}
+		}
+
+		std::size_t size() const
+		{
+			return state_->results.has_value() ? state_->results.rows().size() : 0;
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		row_proxy operator[](std::size_t pos) const
+		{
+			return row_proxy(state_, pos);
+		}
+
+		const_iterator begin() const
+		{
+			return const_iterator(state_, 0);
+		}
+
+		const_iterator end() const
+		{
+			return const_iterator(state_, size());
+		}
+
+	private:
+		std::shared_ptr<state> state_;
+	};
+} // namespace aquarius
@@ -0,0 +1,208 @@
+#pragma once
+#include <aquarius/mysql/generate_sql.hpp>
+#include <aquarius/mysql/service_pool.hpp>
+#include <aquarius/mysql/string_literal.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace aquarius
+{
+	enum class scan_mode
+	{
+		ordered,
+		unordered
+	};
+
+	struct scan_range
+	{
+		int64_t min_key;
+		int64_t max_key;
+		int64_t rows;
+	};
+
+	inline std::vector<std::pair<int64_t, int64_t>> split_range(const scan_range& range, std::size_t partitions)
+	{
+		std::vector<std::pair<int64_t, int64_t>> ranges{};
+
+		if (range.rows == 0 || range.max_key < range.min_key)
+			return ranges;
+
+		const uint64_t distance = static_cast<uint64_t>(range.max_key) - static_cast<uint64_t>(range.min_key);
+
+		const uint64_t parts = std::max<uint64_t>(1, distance < partitions ? distance + 1 : partitions);
+
+		const uint64_t step = distance / parts;
+
+		const uint64_t max_key = static_cast<uint64_t>(range.max_key);
+
+		for (uint64_t i = 0, begin = static_cast<uint64_t>(range.min_key); i < parts; ++i)
+		{
+			const uint64_t last = max_key - begin <= step ? max_key : begin + step;
+
+			ranges.emplace_back(static_cast<int64_t>(begin), static_cast<int64_t>(last));
+
+			if (last == max_key)
+				break;
+
+			begin = last + 1;
+		}
+
+		return ranges;
+	}
+
+	template <typename _Service, typename _Ty, string_literal key>
+	class parallel_scan
+	{
+		static constexpr std::string_view key_name = bind_param<key>::value;
+
+		static constexpr std::string_view table_name = name<_Ty>();
+
+	public:
+		explicit parallel_scan(service_pool<_Service>& pool, std::size_t partitions = 0)
+			: pool_(pool)
+			, partitions_(partitions == 0 ? pool.capacity() : partitions)
+		{}
+
+		~parallel_scan() = default;
+
+	public:
+		template <typename _Attr>
+		parallel_scan& where(_Attr&& attr)
+		{
+			filter_ = attr.sql();
+
+			return *this;
+		}
+
+		std::vector<_Ty> query(scan_mode mode = scan_mode::unordered)
+		{
+			std::vector<_Ty> result{};
+
+			scan([&](std::vector<_Ty>&& part) { std::move(part.begin(), part.end(), std::back_inserter(result)); },
+				 mode);
+
+			return result;
+		}
+
+		template <typename _Func>
+		void scan(_Func&& f, scan_mode mode = scan_mode::unordered)
+		{
+			auto ranges = split_range(key_range(), partitions_);
+
+			if (ranges.empty())
+				return;
+
+			auto sqls = make_partition_sql(ranges, mode);
+
+			std::vector<std::vector<_Ty>> parts(mode == scan_mode::ordered ? sqls.size() : 0);
+
+			std::atomic<std::size_t> next{ 0 };
+
+			std::mutex stream_mutex{};
+
+			std::vector<std::future<void>> workers{};
+
+			for (std::size_t i = 0; i < std::min(sqls.size(), pool_.capacity()); ++i)
+			{
+				workers.push_back(std::async(std::launch::async,
+											 [&]
+											 {
+												 for (auto pos = next.fetch_add(1); pos < sqls.size();
+													  pos = next.fetch_add(1))
+												 {
+													 auto part = pool_.template query<_Ty>(sqls[pos]);
+
+													 if (mode == scan_mode::ordered)
+													 {
+														 parts[pos] = std::move(part);
+
+														 continue;
+													 }
+
+													 std::lock_guard lk(stream_mutex);
+
+													 f(std::move(part));
+												 }
+											 }));
+			}
+
+			for (auto& worker : workers)
+			{
+				worker.get();
+			}
+
+			for (auto& part : parts)
+			{
+				f(std::move(part));
+			}
+		}
+
+	private:
+		scan_range key_range()
+		{
+			constexpr auto temp_sql = concat_v<SELECT, SPACE, MIN, LEFT_BRACKET, key_name, RIGHT_BRACKET, COMMA, SPACE,
+											   MAX, LEFT_BRACKET, key_name, RIGHT_BRACKET, COMMA, SPACE, COUNT,
+											   LEFT_BRACKET, ASTERISK, RIGHT_BRACKET, SPACE, FROM, SPACE, table_name>;
+
+			std::string sql(temp_sql.data(), temp_sql.size());
+
+			if (!filter_.empty())
+				sql += " where" + filter_;
+
+			auto result = pool_.template query<scan_range>(sql);
+
+			if (result.empty())
+				return {};
+
+			return result.front();
+		}
+
+		std::vector<std::string> make_partition_sql(const std::vector<std::pair<int64_t, int64_t>>& ranges,
+													scan_mode mode)
+		{
+			std::string select_sql{};
+
+			make_select_sql<_Ty, bind_param<"">::value>(select_sql);
+
+			std::vector<std::string> sqls{};
+
+			for (auto& [begin, last] : ranges)
+			{
+				auto sql = select_sql;
+
+				sql += concat_v<SPACE, WHERE, SPACE, key_name, SPACE, GREATER, EQUAL, SPACE>;
+				sql += std::to_string(begin);
+				sql += concat_v<SPACE, AND, SPACE, key_name, SPACE, LESS, EQUAL, SPACE>;
+				sql += std::to_string(last);
+
+				if (!filter_.empty())
+				{
+					sql += concat_v<SPACE, AND, SPACE, LEFT_BRACKET>;
+					sql += filter_;
+					sql += RIGHT_BRACKET;
+				}
+
+				if (mode == scan_mode::ordered)
+					sql += concat_v<SPACE, ORDER, SPACE, BY, SPACE, key_name>;
+
+				sql += SEPARATOR;
+
+				sqls.push_back(std::move(sql));
+			}
+
+			return sqls;
+		}
+
+	private:
+		service_pool<_Service>& pool_;
+
+		std::size_t partitions_;
+
+		std::string filter_;
+	};
+} // namespace aquarius
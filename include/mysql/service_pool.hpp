@@ -1,11 +1,25 @@
 #pragma once
 #include <algorithm>
 #include <aquarius/io_service_pool.hpp>
+#include <aquarius/mysql/capture.hpp>
+#include <aquarius/mysql/column_map.hpp>
+#include <aquarius/mysql/column_result.hpp>
+#include <aquarius/mysql/concurrency.hpp>
+#include <aquarius/mysql/digest.hpp>
+#include <aquarius/mysql/join.hpp>
+#include <aquarius/mysql/metrics.hpp>
+#include <aquarius/mysql/pmr_result.hpp>
+#include <aquarius/mysql/priority.hpp>
+#include <aquarius/mysql/result_view.hpp>
+#include <aquarius/mysql/slow_log.hpp>
+#include <aquarius/mysql/string_literal.hpp>
+#include <aquarius/mysql/tracing.hpp>
 #include <boost/mysql.hpp>
 #include <deque>
 #include <format>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace aquarius
 {
@@ -26,8 +40,162 @@ namespace aquarius
 
 		~service_pool() = default;
 
+		std::size_t capacity() const
+		{
+			return connect_number;
+		}
+
+		pool_metrics& metrics()
+		{
+			return metrics_;
+		}
+
+		metrics_snapshot snapshot()
+		{
+			std::size_t idle = 0;
+
+			{
+				std::lock_guard lk(free_mutex_);
+
+				idle = free_queue_.size();
+			}
+
+			return metrics_.snapshot(idle);
+		}
+
+		void enable_byte_metrics(bool value = true)
+		{
+			metrics_.track_bytes(value);
+		}
+
+		std::string prometheus(std::string_view prefix = "aquarius_mysql_")
+		{
+			return to_prometheus(snapshot(), prefix);
+		}
+
+		digest_table& digests()
+		{
+			return digests_;
+		}
+
+		std::vector<digest_snapshot> statements() const
+		{
+			return digests_.snapshot();
+		}
+
+		bool enable_slow_log(slow_query_options options = {})
+		{
+			std::lock_guard lk(free_mutex_);
+
+			if (!configurable("slow log"))
+				return false;
+
+			slow_log_ = std::make_unique<slow_query_log>(std::move(options));
+
+			return true;
+		}
+
+		bool enable_capture(capture_options options = {})
+		{
+			std::lock_guard lk(free_mutex_);
+
+			if (!configurable("capture"))
+				return false;
+
+			capture_ = std::make_unique<capture_writer>(std::move(options));
+
+			if (!*capture_)
+			{
+				XLOG_ERROR() << "capture: open failed!";
+
+				capture_.reset();
+
+				return false;
+			}
+
+			return true;
+		}
+
+		bool enable_priority(priority_options options = {})
+		{
+			if (options.max_connections == 0)
+				options.max_connections = capacity();
+
+			if (options.max_connections > capacity())
+			{
+				XLOG_ERROR() << "pool: priority max_connections " << options.max_connections << " exceeds capacity "
+							 << capacity() << "!";
+
+				return false;
+			}
+
+			priorities_.configure(options);
+
+			return true;
+		}
+
+		priority_gate& priorities()
+		{
+			return priorities_;
+		}
+
+		bool enable_concurrency_limit(concurrency_options options = {})
+		{
+			std::lock_guard lk(free_mutex_);
+
+			if (!configurable("concurrency limit"))
+				return false;
+
+			limiter_ = std::make_unique<concurrency_limiter>(options);
+
+			return true;
+		}
+
+		const concurrency_limiter* limiter() const
+		{
+			return limiter_.get();
+		}
+
+		bool wait_ready()
+		{
+			if constexpr (requires(_Service& conn) { conn.wait_ready(); })
+			{
+				std::vector<_Service*> conns{};
+
+				{
+					std::lock_guard lk(free_mutex_);
+
+					for (auto& conn : free_queue_)
+					{
+						conns.push_back(conn.get());
+					}
+				}
+
+				bool ready = true;
+
+				for (auto conn : conns)
+				{
+					ready = conn->wait_ready() && ready;
+				}
+
+				return ready;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		void flush_capture()
+		{
+			if (capture_)
+				capture_->flush();
+		}
+
 		void stop()
 		{
+			explainer_.stop();
+
 			std::lock_guard lk(free_mutex_);
 
 			while (!free_queue_.empty())
@@ -35,93 +203,729 @@ namespace aquarius
 				auto& front = free_queue_.front();
 
 				if (front)
+				{
 					front->close();
 
+					metrics_.connection_closed();
+				}
+
 				free_queue_.pop_front();
 			}
 		}
 
 		bool execute(const std::string& sql)
 		{
-			auto conn_ptr = get_service();
+			boost::mysql::error_code ec;
 
-			if (conn_ptr == nullptr)
-				conn_ptr = std::make_unique<_Service>(pool_.get_io_service(), endpoint_, params_);
+			return execute(sql, ec);
+		}
+
+		bool execute(const std::string& sql, boost::mysql::error_code& ec)
+		{
+			scoped_span span(span_name::query);
+
+			if (!admit(span, sql, ec))
+				return false;
+
+			auto conn_ptr = acquire();
+
+			auto start = std::chrono::steady_clock::now();
 
+			auto res = conn_ptr->execute(sql, ec);
+
+			if (!res)
+			{
+				XLOG_ERROR() << "sql: " << sql << " execute failed! " << ec.what();
+			}
+
+			completed(span, *conn_ptr, sql, elapsed_ns(start), ec);
+
+			this->recycle_service(std::move(conn_ptr));
+
+			return res;
+		}
+
+		bool execute(const std::string& sql, const std::vector<boost::mysql::field_view>& params)
+		{
 			boost::mysql::error_code ec;
 
-			if (!conn_ptr->execute(sql, ec))
+			return execute(sql, params, ec);
+		}
+
+		bool execute(const std::string& sql, const std::vector<boost::mysql::field_view>& params,
+					 boost::mysql::error_code& ec)
+		{
+			scoped_span span(span_name::query);
+
+			if (!admit(span, sql, ec))
+				return false;
+
+			auto conn_ptr = acquire();
+
+			auto start = std::chrono::steady_clock::now();
+
+			auto res = conn_ptr->execute(sql, params, ec);
+
+			completed(span, *conn_ptr, sql, elapsed_ns(start), ec, 0, 0, &params);
+
+			if (!res)
 			{
 				XLOG_ERROR() << "sql: " << sql << " execute failed! " << ec.what();
 			}
 
 			this->recycle_service(std::move(conn_ptr));
 
-			return true;
+			return res;
 		}
 
 		template <typename _Func>
 		auto async_execute(const std::string& sql, _Func&& f)
 		{
-			auto conn_ptr = get_service();
+			return dispatch_execute(sql, nullptr, std::forward<_Func>(f));
+		}
 
-			if (conn_ptr == nullptr)
-				conn_ptr = std::make_unique<_Service>(pool_.get_io_service(), endpoint_, params_);
+		template <typename _Func>
+		auto async_execute(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f)
+		{
+			return dispatch_execute(sql, own_params(params), std::forward<_Func>(f));
+		}
+
+		template <typename _Ty, string_literal... args>
+		std::vector<_Ty> query(const std::string& sql, const std::vector<boost::mysql::field_view>& params = {})
+		{
+			boost::mysql::error_code ec;
+
+			return query<_Ty, args...>(sql, ec, params);
+		}
+
+		template <typename _Ty, string_literal... args>
+		std::vector<_Ty> query(const std::string& sql, boost::mysql::error_code& ec,
+							   const std::vector<boost::mysql::field_view>& params = {})
+		{
+			std::vector<_Ty> result{};
+
+			fetch<_Ty, args...>(sql, result, ec, params);
+
+			return result;
+		}
+
+		template <typename _Ty>
+		pmr_result<_Ty> query_pmr(const std::string& sql, const std::vector<boost::mysql::field_view>& params = {})
+		{
+			pmr_result<_Ty> result{};
+
+			fetch<_Ty>(sql, result, params);
+
+			return result;
+		}
+
+		template <typename _Ty>
+		column_result<_Ty> query_columns(const std::string& sql,
+										 const std::vector<boost::mysql::field_view>& params = {})
+		{
+			column_result<_Ty> result{};
+
+			fetch<_Ty>(sql, result, params);
+
+			return result;
+		}
+
+		template <typename _Tuple>
+		std::vector<_Tuple> query_join(const std::string& sql, const std::vector<boost::mysql::field_view>& params = {})
+		{
+			std::vector<_Tuple> result{};
+
+			std::optional<join_index_t<_Tuple>> index{};
+
+			query_rows(sql, params,
+					   [&](const boost::mysql::row_view& row, const boost::mysql::metadata_collection_view& meta)
+					   {
+						   if (!index)
+							   index = make_join_index<_Tuple>(meta);
+
+						   result.push_back(to_join<_Tuple>(row, *index));
+					   });
+
+			return result;
+		}
 
-			return conn_ptr->async_excute(sql,
-								   [&, ptr = std::move(conn_ptr), func = std::move(f)](bool value) mutable
-								   {
-									   func(std::move(value));
+		template <typename _Ty>
+		std::optional<_Ty> query_scalar(const std::string& sql,
+										const std::vector<boost::mysql::field_view>& params = {})
+		{
+			std::optional<_Ty> result{};
 
-									   this->recycle_service(std::move(ptr));
-								   });
+			fetch<_Ty>(sql, result, params);
+
+			return result;
 		}
 
 		template <typename _Ty>
-		std::vector<_Ty> query(const std::string& sql)
+		result_view<_Ty> query_view(const std::string& sql, const std::vector<boost::mysql::field_view>& params = {})
+		{
+			result_view<_Ty> result{};
+
+			fetch<_Ty>(sql, result, params);
+
+			return result;
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, _Func&& f)
+		{
+			boost::mysql::error_code ec;
+
+			return read_rows(sql, nullptr, std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, _Func&& f, boost::mysql::error_code& ec)
+		{
+			return read_rows(sql, nullptr, std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f)
+		{
+			boost::mysql::error_code ec;
+
+			return read_rows(sql, params, std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Func>
+		bool query_rows(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f,
+						boost::mysql::error_code& ec)
+		{
+			return read_rows(sql, params, std::forward<_Func>(f), ec);
+		}
+
+		template <typename _Ty, typename _Func>
+		bool query_stream(const std::string& sql, _Func&& f)
+		{
+			return stream_rows<_Ty>(sql, nullptr, std::forward<_Func>(f));
+		}
+
+		template <typename _Ty, typename _Func>
+		bool query_stream(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f)
+		{
+			return stream_rows<_Ty>(sql, params, std::forward<_Func>(f));
+		}
+
+		template <typename _Ty, typename _Fmt, typename... _Args>
+		auto async_pquery(_Fmt&& f, _Args&&... args)
+		{
+			return async_query<_Ty>(std::format(std::forward<_Fmt>(f), std::forward<_Args>(args)...));
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
+		auto async_query(const std::string& sql, _Func&& f)
+		{
+			return dispatch_query<_Ty, args...>(sql, nullptr, std::forward<_Func>(f));
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
+		auto async_query(const std::string& sql, const std::vector<boost::mysql::field_view>& params, _Func&& f)
+		{
+			return dispatch_query<_Ty, args...>(sql, own_params(params), std::forward<_Func>(f));
+		}
+
+	private:
+		template <typename _Params, typename _Func>
+		void dispatch_execute(const std::string& sql, _Params params, _Func&& f)
+		{
+			scoped_span span(span_name::query);
+
+			boost::mysql::error_code ec;
+
+			if (!admit(span, sql, ec))
+			{
+				invoke_handler(f, false, ec);
+
+				return;
+			}
+
+			auto parent = span.get();
+
+			async_acquire(parent,
+						  [this, func = std::move(f), text = sql, params,
+						   span = std::move(span)](service_ptr conn_ptr) mutable
+						  {
+							  auto start = std::chrono::steady_clock::now();
+
+							  auto& conn = *conn_ptr;
+
+							  auto handler =
+								  [this, ptr = std::move(conn_ptr), func = std::move(func), start, text, params,
+								   span = std::move(span)](bool value, const boost::mysql::error_code& ec) mutable
+							  {
+								  auto bound = bound_params(params);
+
+								  completed(span, *ptr, text, elapsed_ns(start), ec, 0, 0,
+											bound.empty() ? nullptr : &bound);
+
+								  invoke_handler(func, std::move(value), ec);
+
+								  this->recycle_service(std::move(ptr));
+
+								  span.end();
+							  };
+
+							  if constexpr (std::is_null_pointer_v<_Params>)
+							  {
+								  conn.async_excute(text, std::move(handler));
+							  }
+							  else
+							  {
+								  conn.async_excute(text, params, std::move(handler));
+							  }
+						  });
+		}
+
+		template <typename _Ty, string_literal... args, typename _Params, typename _Func>
+		void dispatch_query(const std::string& sql, _Params params, _Func&& f)
+		{
+			scoped_span span(span_name::query);
+
+			boost::mysql::error_code ec;
+
+			if (!admit(span, sql, ec))
+			{
+				invoke_handler(f, std::vector<_Ty>{}, ec);
+
+				return;
+			}
+
+			auto parent = span.get();
+
+			async_acquire(parent,
+						  [this, func = std::move(f), text = sql, params,
+						   span = std::move(span)](service_ptr conn_ptr) mutable
+						  {
+							  auto start = std::chrono::steady_clock::now();
+
+							  auto& conn = *conn_ptr;
+
+							  auto handler =
+								  [this, ptr = std::move(conn_ptr), func = std::move(func), start, text, params,
+								   span = std::move(span)](std::vector<_Ty> value, const boost::mysql::error_code& ec) mutable
+							  {
+								  auto bound = bound_params(params);
+
+								  completed(span, *ptr, text, elapsed_ns(start), ec, value.size(), 0,
+											bound.empty() ? nullptr : &bound);
+
+								  invoke_handler(func, std::move(value), ec);
+
+								  this->recycle_service(std::move(ptr));
+
+								  span.end();
+							  };
+
+							  if constexpr (std::is_null_pointer_v<_Params>)
+							  {
+								  conn.template async_query<_Ty, args...>(text, std::move(handler));
+							  }
+							  else
+							  {
+								  conn.template async_query<_Ty, args...>(text, params, std::move(handler));
+							  }
+						  });
+		}
+
+	private:
+		template <typename _Ty, string_literal... args, typename _Result>
+		bool fetch(const std::string& sql, _Result& result, const std::vector<boost::mysql::field_view>& params)
+		{
+			boost::mysql::error_code ec;
+
+			return fetch<_Ty, args...>(sql, result, ec, params);
+		}
+
+		template <typename _Ty, string_literal... args, typename _Result>
+		bool fetch(const std::string& sql, _Result& result, boost::mysql::error_code& ec,
+				   const std::vector<boost::mysql::field_view>& params)
+		{
+			scoped_span span(span_name::query);
+
+			if (!admit(span, sql, ec))
+				return false;
+
+			auto conn_ptr = acquire();
+
+			auto start = std::chrono::steady_clock::now();
+
+			auto res = conn_ptr->template query<_Ty, args...>(sql, result, ec, params);
+
+			completed(span, *conn_ptr, sql, elapsed_ns(start), ec, result_rows(result), last_bytes(*conn_ptr),
+					  params.empty() ? nullptr : &params);
+
+			if (!res)
+			{
+				XLOG_ERROR() << "sql: " << sql << " query failed! " << ec.what();
+			}
+
+			this->recycle_service(std::move(conn_ptr));
+
+			return res;
+		}
+
+		template <typename _Params, typename _Func>
+		bool read_rows(const std::string& sql, const _Params& params, _Func&& f, boost::mysql::error_code& ec)
+		{
+			scoped_span span(span_name::query);
+
+			if (!admit(span, sql, ec))
+				return false;
+
+			auto conn_ptr = acquire();
+
+			std::uint64_t rows = 0;
+
+			std::uint64_t bytes = 0;
+
+			auto count = metrics_.tracking_bytes();
+
+			auto start = std::chrono::steady_clock::now();
+
+			auto handler = [&](const auto& row, const auto& meta)
+			{
+				++rows;
+
+				if (count)
+					bytes += row_bytes(row);
+
+				f(row, meta);
+			};
+
+			bool res = false;
+
+			const std::vector<boost::mysql::field_view>* bound = nullptr;
+
+			if constexpr (std::is_null_pointer_v<_Params>)
+			{
+				res = conn_ptr->query_rows(sql, handler, ec);
+			}
+			else
+			{
+				res = conn_ptr->query_rows(sql, params, handler, ec);
+
+				bound = params.empty() ? nullptr : &params;
+			}
+
+			completed(span, *conn_ptr, sql, elapsed_ns(start), ec, rows, bytes, bound);
+
+			if (!res)
+			{
+				XLOG_ERROR() << "sql: " << sql << " query failed! " << ec.what();
+			}
+
+			this->recycle_service(std::move(conn_ptr));
+
+			return res;
+		}
+
+		template <typename _Ty, typename _Params, typename _Func>
+		bool stream_rows(const std::string& sql, const _Params& params, _Func&& f)
+		{
+			std::array<std::size_t, tuple_size_v<_Ty>> index = identity_index<_Ty>();
+
+			bool mapped = false;
+
+			boost::mysql::error_code ec;
+
+			return read_rows(sql, params,
+							 [&](const boost::mysql::row_view& row, const boost::mysql::metadata_collection_view& meta)
+							 {
+								 if constexpr (named_fields_t<_Ty>)
+								 {
+									 if (!mapped)
+									 {
+										 index = column_map<_Ty>::get(meta);
+										 mapped = true;
+									 }
+								 }
+
+								 f(to_struct<_Ty>(row, index));
+							 },
+							 ec);
+		}
+
+		static std::shared_ptr<const std::vector<boost::mysql::field>> own_params(
+			const std::vector<boost::mysql::field_view>& params)
+		{
+			return std::make_shared<const std::vector<boost::mysql::field>>(params.begin(), params.end());
+		}
+
+		static std::vector<boost::mysql::field_view> bound_params(std::nullptr_t)
+		{
+			return {};
+		}
+
+		static std::vector<boost::mysql::field_view> bound_params(
+			const std::shared_ptr<const std::vector<boost::mysql::field>>& params)
+		{
+			return std::vector<boost::mysql::field_view>(params->begin(), params->end());
+		}
+
+		template <typename _Func, typename _Value>
+		static void invoke_handler(_Func& f, _Value&& value, const boost::mysql::error_code& ec)
+		{
+			if constexpr (std::invocable<_Func&, _Value, const boost::mysql::error_code&>)
+			{
+				f(std::forward<_Value>(value), ec);
+			}
+			else
+			{
+				f(std::forward<_Value>(value));
+			}
+		}
+
+		bool admit(scoped_span& span, const std::string& sql, boost::mysql::error_code& ec)
+		{
+			if (!limiter_ || limiter_->try_acquire())
+				return true;
+
+			ec = make_error_code(pool_errc::overloaded);
+
+			span.set_error(ec);
+
+			XLOG_ERROR() << "sql: " << sql << " rejected! " << ec.message();
+
+			return false;
+		}
+
+		void completed(scoped_span& span, _Service& conn, const std::string& sql, std::uint64_t latency_ns,
+					   const boost::mysql::error_code& ec, std::uint64_t rows = 0, std::uint64_t bytes = 0,
+					   const std::vector<boost::mysql::field_view>* params = nullptr)
+		{
+			if (span)
+			{
+				span.set_attribute("db.system", "mysql");
+				span.set_attribute("db.statement", sql);
+				span.set_attribute("db.rows", rows);
+				span.set_error(ec);
+			}
+
+			if (limiter_)
+				limiter_->release(latency_ns);
+
+			metrics_.executed(latency_ns, ec);
+
+			metrics_.decoded(rows, bytes);
+
+			digests_.record(sql, latency_ns, static_cast<bool>(ec), rows, bytes);
+
+			if (slow_log_ && latency_ns >= slow_log_->threshold_ns())
+				log_slow(conn, sql, latency_ns, params);
+
+			if (capture_)
+				log_capture(conn, sql, latency_ns, static_cast<bool>(ec), rows, params);
+		}
+
+		void log_capture(_Service& conn, const std::string& sql, std::uint64_t latency_ns, bool failed,
+						 std::uint64_t rows, const std::vector<boost::mysql::field_view>* params)
+		{
+			capture_record record{};
+
+			record.time_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+															std::chrono::system_clock::now().time_since_epoch())
+															.count()) -
+							 latency_ns;
+			record.connection_id = connection_id(conn);
+			record.latency_ns = latency_ns;
+			record.rows = rows;
+			record.failed = failed;
+
+			if (params != nullptr)
+			{
+				std::vector<std::string> literals{};
+
+				for (const auto& param : *params)
+				{
+					literals.push_back(to_sql_literal(param));
+				}
+
+				record.sql = inline_params(sql, literals);
+			}
+			else
+			{
+				record.sql = sql;
+			}
+
+			capture_->write(record);
+		}
+
+		void log_slow(_Service& conn, const std::string& sql, std::uint64_t latency_ns,
+					  const std::vector<boost::mysql::field_view>* params)
+		{
+			slow_query_record record{};
+
+			record.time = std::chrono::system_clock::now();
+			record.latency_ns = latency_ns;
+			record.connection_id = connection_id(conn);
+			record.digest = digest_hash(fingerprint(sql));
+			record.sql = sql;
+
+			if (params != nullptr)
+			{
+				for (const auto& param : *params)
+				{
+					record.params.push_back(to_sql_literal(param));
+				}
+			}
+
+			if constexpr (explainable<_Service>)
+			{
+				if (slow_log_->explain_due(record.digest))
+				{
+					auto posted = explainer_.post(
+						[this, record]() mutable
+						{
+							explain(record);
+
+							slow_log_->write(record);
+						});
+
+					if (posted)
+						return;
+				}
+			}
+
+			slow_log_->write(record);
+		}
+
+		void explain(slow_query_record& record)
 		{
 			auto conn_ptr = get_service();
 
 			if (conn_ptr == nullptr)
-				conn_ptr = std::make_unique<_Service>(pool_.get_io_service(), endpoint_, params_);
+				return;
+
+			metrics_.acquired(0);
+
+			std::string sql{};
+
+			sql.append(EXPLAIN).append(SPACE).append(FORMAT_JSON).append(SPACE);
+
+			sql += inline_params(record.sql, record.params);
 
 			boost::mysql::error_code ec;
 
-			std::vector<_Ty> result{};
-			if (!conn_ptr->query<_Ty>(sql, result, ec))
+			conn_ptr->query_rows(
+				sql,
+				[&](const boost::mysql::row_view& row, const auto&)
+				{
+					if (!row.empty() && row[0].is_string())
+						record.plan = row[0].as_string();
+				},
+				ec);
+
+			if (ec)
 			{
-				XLOG_ERROR() << "sql: " << sql << " query failed! " << ec.what();
+				XLOG_ERROR() << "sql: " << sql << " explain failed! " << ec.what();
 			}
 
 			this->recycle_service(std::move(conn_ptr));
+		}
 
-			return result;
+		static std::uint64_t connection_id(_Service& conn)
+		{
+			if constexpr (requires { conn.connection_id(); })
+			{
+				return conn.connection_id();
+			}
+			else
+			{
+				return 0;
+			}
 		}
 
-		template <typename _Ty, typename _Fmt, typename... _Args>
-		auto async_pquery(_Fmt&& f, _Args&&... args)
+		template <typename _Result>
+		static std::uint64_t result_rows(const _Result& result)
 		{
-			return async_query<_Ty>(std::format(std::forward<_Fmt>(f), std::forward<_Args>(args)...));
+			if constexpr (requires { result.has_value(); })
+			{
+				return result.has_value() ? 1 : 0;
+			}
+			else
+			{
+				return result.size();
+			}
 		}
 
-		template <typename _Ty, typename _Func>
-		auto async_query(const std::string& sql, _Func&& f)
+		static std::uint64_t last_bytes(const _Service& conn)
+		{
+			if constexpr (requires { conn.last_bytes(); })
+			{
+				return conn.last_bytes();
+			}
+			else
+			{
+				return 0;
+			}
+		}
+
+		service_ptr acquire()
+		{
+			scoped_span span(span_name::acquire);
+
+			auto start = std::chrono::steady_clock::now();
+
+			auto priority = scoped_priority::current();
+
+			auto entered = priorities_.enter(priority);
+
+			return take_service(span, start, priority, entered);
+		}
+
+		template <typename _Func>
+		void async_acquire(trace_span* parent, _Func&& f)
+		{
+			scoped_span span(span_name::acquire, parent, {}, false);
+
+			auto start = std::chrono::steady_clock::now();
+
+			auto priority = scoped_priority::current();
+
+			priorities_.async_enter(priority,
+									[this, start, priority, span = std::move(span),
+									 func = std::forward<_Func>(f)](bool entered) mutable
+									{
+										auto conn_ptr = take_service(span, start, priority, entered);
+
+										span.end();
+
+										func(std::move(conn_ptr));
+									});
+		}
+
+		service_ptr take_service(scoped_span& span, std::chrono::steady_clock::time_point start,
+								 priority_class priority, bool entered)
 		{
 			auto conn_ptr = get_service();
 
 			if (conn_ptr == nullptr)
+			{
 				conn_ptr = std::make_unique<_Service>(pool_.get_io_service(), endpoint_, params_);
 
-			return conn_ptr->template async_query<_Ty>(sql,
-												  [&, ptr = std::move(conn_ptr), func = std::move(f)](const std::vector<_Ty>& value) mutable
-												  {
-													  func(value);
+				metrics_.connection_created();
 
-													  this->recycle_service(std::move(ptr));
-												  });
+				span.set_attribute("mysql.connection.created", 1);
+			}
+
+			if (entered)
+				priorities_.lease(conn_ptr.get(), priority);
+
+			if constexpr (requires { conn_ptr->count_bytes(true); })
+			{
+				conn_ptr->count_bytes(metrics_.tracking_bytes());
+			}
+
+			metrics_.acquired(elapsed_ns(start));
+
+			return conn_ptr;
 		}
 
-	private:
 		template <typename... _Args>
 		void make_service_pool(io_service_pool& pool, _Args&&... args)
 		{
@@ -130,13 +934,27 @@ namespace aquarius
 			for (std::size_t i = 0; i < connect_number; i++)
 			{
 				free_queue_.push_back(std::make_unique<_Service>(pool.get_io_service(), endpoint_, params_));
+
+				metrics_.connection_created();
 			}
 		}
 
+		bool configurable(std::string_view option) const
+		{
+			if (!started_)
+				return true;
+
+			XLOG_ERROR() << "pool: " << option << " must be enabled before the first query!";
+
+			return false;
+		}
+
 		service_ptr get_service()
 		{
 			std::lock_guard lk(free_mutex_);
 
+			started_ = true;
+
 			if (free_queue_.empty())
 				return nullptr;
 
@@ -151,9 +969,20 @@ namespace aquarius
 
 		void recycle_service(service_ptr&& conn_ptr)
 		{
-			std::lock_guard lk(free_mutex_);
+			metrics_.released();
+
+			bool leased = false;
 
-			free_queue_.push_back(std::move(conn_ptr));
+			{
+				std::lock_guard lk(free_mutex_);
+
+				leased = priorities_.leave(conn_ptr.get());
+
+				free_queue_.push_back(std::move(conn_ptr));
+			}
+
+			if (leased)
+				priorities_.notify();
 		}
 
 		template <typename _Host, typename _Passwd, typename... _Args>
@@ -176,5 +1005,21 @@ namespace aquarius
 		boost::asio::ip::tcp::resolver::results_type endpoint_;
 
 		std::shared_ptr<boost::mysql::handshake_params> params_;
+
+		pool_metrics metrics_;
+
+		digest_table digests_;
+
+		std::unique_ptr<slow_query_log> slow_log_;
+
+		std::unique_ptr<capture_writer> capture_;
+
+		priority_gate priorities_;
+
+		std::unique_ptr<concurrency_limiter> limiter_;
+
+		bool started_ = false;
+
+		explain_worker explainer_;
 	};
 } // namespace aquarius
\ No newline at end of file
@@ -0,0 +1,437 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/digest.hpp>
+#include <aquarius/mysql/keyword.hpp>
+#include <boost/mysql.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	struct slow_query_options
+	{
+		std::chrono::milliseconds threshold{ 1000 };
+
+		bool explain = true;
+
+		std::chrono::seconds explain_interval{ 300 };
+
+		std::string path = "slow_query.log";
+
+		std::size_t max_bytes = 64 * 1024 * 1024;
+
+		std::size_t max_files = 4;
+	};
+
+	struct slow_query_record
+	{
+		std::chrono::system_clock::time_point time;
+
+		std::uint64_t latency_ns = 0;
+
+		std::uint64_t connection_id = 0;
+
+		std::uint64_t digest = 0;
+
+		std::string sql;
+
+		std::vector<std::string> params;
+
+		std::string plan;
+	};
+
+	template <typename _Ty>
+	concept explainable =
+		requires(_Ty& conn, const std::string& sql, boost::mysql::error_code& ec) {
+			conn.query_rows(
+				sql, [](const boost::mysql::row_view&, const boost::mysql::metadata_collection_view&) {}, ec);
+		};
+
+	inline std::string to_sql_literal(const boost::mysql::field_view& field)
+	{
+		std::string result{};
+
+		if (field.is_null())
+		{
+			result = NULL_VALUE;
+		}
+		else if (field.is_int64())
+		{
+			result = std::to_string(field.get_int64());
+		}
+		else if (field.is_uint64())
+		{
+			result = std::to_string(field.get_uint64());
+		}
+		else if (field.is_double())
+		{
+			append_sql_value(result, field.get_double());
+		}
+		else if (field.is_float())
+		{
+			append_sql_value(result, field.get_float());
+		}
+		else if (field.is_string())
+		{
+			append_sql_value(result, field.get_string());
+		}
+		else
+		{
+			std::ostringstream os{};
+
+			os << field;
+
+			append_sql_value(result, os.str());
+		}
+
+		return result;
+	}
+
+	inline std::string inline_params(std::string_view sql, const std::vector<std::string>& params)
+	{
+		std::string result{};
+
+		result.reserve(sql.size() + params.size() * 8);
+
+		std::size_t index = 0;
+
+		for (std::size_t pos = 0; pos < sql.size();)
+		{
+			auto c = sql[pos];
+
+			if (c == '\'' || c == '"' || c == '`')
+			{
+				auto end = c == '`' ? sql.find('`', pos + 1) + 1 : detail::skip_quoted(sql, pos);
+
+				end = std::min(end == 0 ? sql.size() : end, sql.size());
+
+				result.append(sql.substr(pos, end - pos));
+
+				pos = end;
+
+				continue;
+			}
+
+			if (c == '?' && index < params.size())
+			{
+				result += params[index++];
+			}
+			else
+			{
+				result += c;
+			}
+
+			++pos;
+		}
+
+		return result;
+	}
+
+	namespace detail
+	{
+		inline void append_json_string(std::string& out, std::string_view value)
+		{
+			out += '"';
+
+			for (auto c : value)
+			{
+				switch (c)
+				{
+				case '"':
+					out += "\\\"";
+					break;
+				case '\\':
+					out += "\\\\";
+					break;
+				case '\n':
+					out += "\\n";
+					break;
+				case '\r':
+					out += "\\r";
+					break;
+				case '\t':
+					out += "\\t";
+					break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+					{
+						char buffer[8]{};
+
+						std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+
+						out += buffer;
+					}
+					else
+					{
+						out += c;
+					}
+					break;
+				}
+			}
+
+			out += '"';
+		}
+	} // namespace detail
+
+	inline std::string to_json(const slow_query_record& record)
+	{
+		std::string out{};
+
+		out.reserve(record.sql.size() + record.plan.size() + 128);
+
+		out += "{\"time_ms\":";
+		out += std::to_string(
+			std::chrono::duration_cast<std::chrono::milliseconds>(record.time.time_since_epoch()).count());
+		out += ",\"latency_ms\":";
+		append_sql_value(out, static_cast<double>(record.latency_ns) / 1e6);
+		out += ",\"connection_id\":";
+		out += std::to_string(record.connection_id);
+		out += ",\"digest\":\"";
+		out += std::format("{:016x}", record.digest);
+		out += "\",\"sql\":";
+		detail::append_json_string(out, record.sql);
+		out += ",\"params\":[";
+
+		for (std::size_t i = 0; i < record.params.size(); ++i)
+		{
+			if (i != 0)
+				out += ',';
+
+			detail::append_json_string(out, record.params[i]);
+		}
+
+		out += "],\"plan\":";
+		out += record.plan.empty() ? std::string_view("null") : std::string_view(record.plan);
+		out += "}\n";
+
+		return out;
+	}
+
+	class rotating_file
+	{
+	public:
+		rotating_file(std::filesystem::path path, std::size_t max_bytes, std::size_t max_files)
+			: path_(std::move(path))
+			, max_bytes_(max_bytes)
+			, max_files_(max_files)
+		{}
+
+	public:
+		void write(std::string_view line)
+		{
+			std::lock_guard lk(mutex_);
+
+			if (!stream_.is_open())
+				open();
+
+			if (size_ != 0 && size_ + line.size() > max_bytes_)
+				rotate();
+
+			stream_.write(line.data(), line.size());
+
+			stream_.flush();
+
+			size_ += line.size();
+		}
+
+	private:
+		void open()
+		{
+			stream_.open(path_, std::ios::binary | std::ios::app);
+
+			std::error_code ec{};
+
+			auto size = std::filesystem::file_size(path_, ec);
+
+			size_ = ec ? 0 : static_cast<std::size_t>(size);
+		}
+
+		void rotate()
+		{
+			stream_.close();
+
+			std::error_code ec{};
+
+			for (auto index = max_files_; index > 1; --index)
+			{
+				std::filesystem::rename(indexed(index - 1), indexed(index), ec);
+			}
+
+			if (max_files_ > 0)
+				std::filesystem::rename(path_, indexed(1), ec);
+			else
+				std::filesystem::remove(path_, ec);
+
+			stream_.open(path_, std::ios::binary | std::ios::trunc);
+
+			size_ = 0;
+		}
+
+		std::filesystem::path indexed(std::size_t index) const
+		{
+			auto path = path_;
+
+			path += "." + std::to_string(index);
+
+			return path;
+		}
+
+	private:
+		std::filesystem::path path_;
+
+		std::size_t max_bytes_;
+
+		std::size_t max_files_;
+
+		std::mutex mutex_;
+
+		std::ofstream stream_;
+
+		std::size_t size_ = 0;
+	};
+
+	class slow_query_log
+	{
+	public:
+		explicit slow_query_log(slow_query_options options)
+			: options_(std::move(options))
+			, file_(options_.path, options_.max_bytes, options_.max_files)
+		{}
+
+	public:
+		std::uint64_t threshold_ns() const
+		{
+			return static_cast<std::uint64_t>(std::chrono::nanoseconds(options_.threshold).count());
+		}
+
+		bool explain_due(std::uint64_t digest)
+		{
+			if (!options_.explain)
+				return false;
+
+			auto now = std::chrono::steady_clock::now();
+
+			std::lock_guard lk(mutex_);
+
+			auto [iter, inserted] = explained_.try_emplace(digest, now);
+
+			if (!inserted && now - iter->second < options_.explain_interval)
+				return false;
+
+			iter->second = now;
+
+			return true;
+		}
+
+		void write(const slow_query_record& record)
+		{
+			file_.write(to_json(record));
+		}
+
+	private:
+		slow_query_options options_;
+
+		rotating_file file_;
+
+		std::mutex mutex_;
+
+		std::unordered_map<std::uint64_t, std::chrono::steady_clock::time_point> explained_;
+	};
+
+	class explain_worker
+	{
+	public:
+		explain_worker() = default;
+
+		explain_worker(const explain_worker&) = delete;
+
+		explain_worker& operator=(const explain_worker&) = delete;
+
+		~explain_worker()
+		{
+			stop();
+		}
+
+	public:
+		bool post(std::function<void()> job)
+		{
+			std::lock_guard lk(mutex_);
+
+			if (stopped_)
+				return false;
+
+			jobs_.push_back(std::move(job));
+
+			if (!thread_.joinable())
+				thread_ = std::thread([this] { run(); });
+
+			ready_.notify_one();
+
+			return true;
+		}
+
+		void stop()
+		{
+			{
+				std::lock_guard lk(mutex_);
+
+				stopped_ = true;
+			}
+
+			ready_.notify_one();
+
+			if (thread_.joinable())
+				thread_.join();
+		}
+
+	private:
+		void run()
+		{
+			std::unique_lock lk(mutex_);
+
+			for (;;)
+			{
+				ready_.wait(lk, [&] { return stopped_ || !jobs_.empty(); });
+
+				if (jobs_.empty())
+					return;
+
+				auto job = std::move(jobs_.front());
+
+				jobs_.pop_front();
+
+				lk.unlock();
+
+				job();
+
+				lk.lock();
+			}
+		}
+
+	private:
+		std::mutex mutex_;
+
+		std::condition_variable ready_;
+
+		std::deque<std::function<void()>> jobs_;
+
+		bool stopped_ = false;
+
+		std::thread thread_;
+	};
+} // namespace aquarius
@@ -1,9 +1,17 @@
 #pragma once
 #include <aquarius/mysql/reflect.hpp>
 #include <aquarius/mysql/attributes.hpp>
+#include <aquarius/mysql/column_result.hpp>
+#include <aquarius/mysql/field_types.hpp>
+#include <aquarius/mysql/fixed_string.hpp>
 #include <aquarius/mysql/generate_sql.hpp>
+#include <aquarius/mysql/interned_string.hpp>
+#include <aquarius/mysql/join.hpp>
+#include <aquarius/mysql/pmr_result.hpp>
 #include <aquarius/mysql/service_pool.hpp>
 #include <aquarius/mysql/to_string.hpp>
+#include <deque>
+#include <optional>
 #include <vector>
 
 using namespace std::string_view_literals;
@@ -23,7 +31,10 @@ namespace aquarius
 	public:
 		bool execute()
 		{
-			sql_str_ += ";";
+			finish();
+
+			if (!params_.empty())
+				return pool_.execute(sql_str_, params_);
 
 			return pool_.execute(sql_str_);
 		}
@@ -31,25 +42,94 @@ namespace aquarius
 		template <typename _Func>
 		auto async_execute(_Func&& f)
 		{
-			sql_str_ += ";";
+			finish();
+
+			if (!params_.empty())
+				return pool_.async_execute(sql_str_, params_, std::forward<_Func>(f));
 
 			return pool_.async_execute(sql_str_, std::forward<_Func>(f));
 		}
 
-		template <typename _Ty>
+		template <typename _Ty, string_literal... args>
 		std::vector<_Ty> query()
 		{
-			sql_str_ += ";";
+			finish();
+
+			return pool_.template query<_Ty, args...>(sql_str_, params_);
+		}
+
+		template <typename _Ty>
+		pmr_result<_Ty> query_pmr()
+		{
+			finish();
+
+			return pool_.template query_pmr<_Ty>(sql_str_, params_);
+		}
+
+		template <typename _Ty>
+		column_result<_Ty> query_columns()
+		{
+			finish();
+
+			return pool_.template query_columns<_Ty>(sql_str_, params_);
+		}
+
+		template <typename _Ty>
+		result_view<_Ty> query_view()
+		{
+			finish();
+
+			return pool_.template query_view<_Ty>(sql_str_, params_);
+		}
+
+		template <typename _Tuple>
+		std::vector<_Tuple> query_join()
+		{
+			finish();
+
+			return pool_.template query_join<_Tuple>(sql_str_, params_);
+		}
+
+		template <typename _Ty>
+		std::optional<_Ty> scalar()
+		{
+			finish();
 
-			return pool_.template query<_Ty>(sql_str_);
+			return pool_.template query_scalar<_Ty>(sql_str_, params_);
+		}
+
+		bool any()
+		{
+			make_cat<concat_v<SPACE, LIMIT, SPACE, to_string<1>::value>>(sql_str_);
+
+			return scalar<int>().has_value();
+		}
+
+		template <typename _Func>
+		bool query_rows(_Func&& f)
+		{
+			finish();
+
+			return pool_.query_rows(sql_str_, params_, std::forward<_Func>(f));
 		}
 
 		template <typename _Ty, typename _Func>
+		bool query_stream(_Func&& f)
+		{
+			finish();
+
+			return pool_.template query_stream<_Ty>(sql_str_, params_, std::forward<_Func>(f));
+		}
+
+		template <typename _Ty, string_literal... args, typename _Func>
 		auto async_query(_Func&& f)
 		{
-			sql_str_ += ";";
+			finish();
+
+			if (!params_.empty())
+				return pool_.template async_query<_Ty, args...>(sql_str_, params_, std::forward<_Func>(f));
 
-			return pool_.template async_query<_Ty>(sql_str_, std::forward<_Func>(f));
+			return pool_.template async_query<_Ty, args...>(sql_str_, std::forward<_Func>(f));
 		}
 
 		std::string sql()
@@ -57,16 +137,41 @@ namespace aquarius
 			return sql_str_;
 		}
 
+	private:
+		void finish()
+		{
+			sql_str_ += ";";
+
+			if (!tracing::enabled())
+				return;
+
+			scoped_span span(span_name::build, scoped_span::current(), created_);
+
+			span.set_attribute("db.sql.table", table_);
+			span.set_attribute("db.statement", sql_str_);
+		}
+
 	protected:
 		std::string sql_str_;
 
+		std::string_view table_;
+
+		std::vector<boost::mysql::field_view> params_;
+
+		std::deque<std::string> param_storage_;
+
 	private:
 		service_pool<_Service>& pool_;
+
+		std::chrono::system_clock::time_point created_ =
+			tracing::enabled() ? std::chrono::system_clock::now() : std::chrono::system_clock::time_point{};
 	};
 
-	template <typename _Service>
+	template <typename _Service, typename _Derived = void>
 	class chain_sql : public basic_sql<_Service>
 	{
+		using self_type = std::conditional_t<std::is_void_v<_Derived>, chain_sql, _Derived>;
+
 	public:
 		chain_sql(service_pool<_Service>& pool)
 			: basic_sql<_Service>(pool)
@@ -74,110 +179,333 @@ namespace aquarius
 
 	public:
 		template <typename _Ty>
-		chain_sql& remove()
+		self_type& remove()
 		{
 			make_remove_sql<_Ty>(this->sql_str_);
 
-			return *this;
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
 		}
 
 		template <typename _Ty>
-		chain_sql& insert(_Ty&& t)
+		self_type& insert(_Ty&& t)
 		{
 			make_input_sql<INSERT>(this->sql_str_, std::forward<_Ty>(t));
 
-			return *this;
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
 		}
 
 		template <typename _Ty>
-		chain_sql& update(_Ty&& t)
+		self_type& prepare_insert(const _Ty& t)
+		{
+			make_input_statement<INSERT>(this->sql_str_, t, this->params_, this->param_storage_);
+
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
+		}
+
+		template <typename _Ty>
+		self_type& prepare_replace(const _Ty& t)
+		{
+			make_input_statement<REPLACE>(this->sql_str_, t, this->params_, this->param_storage_);
+
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
+		}
+
+		template <typename _Ty>
+		self_type& update(_Ty&& t)
 		{
 			make_update_sql(this->sql_str_, std::forward<_Ty>(t));
 
-			return *this;
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
 		}
 
 		template <typename _Ty>
-		chain_sql& replace(_Ty&& t)
+		self_type& replace(_Ty&& t)
 		{
 			make_input_sql<REPLACE>(this->sql_str_, std::forward<_Ty>(t));
 
-			return *this;
+			this->table_ = name<std::remove_cvref_t<_Ty>>();
+
+			return self();
 		}
 
 		template <typename _Ty>
-		chain_sql& where(_Ty&& f)
+		self_type& where(_Ty&& f)
 		{
-			this->sql_str_ += " where" + f.sql();
+			this->sql_str_ += " where";
 
-			return *this;
+			f.append(this->sql_str_);
+
+			return self();
+		}
+
+		template <typename _Ty>
+		self_type& prepare_where(_Ty&& f)
+		{
+			this->sql_str_ += " where";
+
+			f.prepare(this->sql_str_, this->params_, this->param_storage_);
+
+			return self();
 		}
 
 		template <typename _Ty, _Ty left_value, _Ty right_value>
-		chain_sql& where_between()
+		self_type& where_between()
 		{
 			constexpr auto sql =
 				concat_v<SPACE, WHERE, SPACE, BETWEEN, SPACE, left_value, SPACE, AND, SPACE, right_value, SEPARATOR>;
 
 			if (this->sql_str_.empty())
-				return *this;
+				return self();
 
 			if (this->sql_str_.back() == ';')
 				this->sql_str_.pop_back();
 
 			this->sql_str_ += sql;
 
-			return *this;
+			return self();
 		}
 
 		template <typename _Ty>
-		chain_sql& where_is_null()
+		self_type& where_is_null()
 		{
 			constexpr auto sql = concat_v<SPACE, WHERE, SPACE, name<_Ty>(), SPACE, IS_NULL, SEPARATOR>;
 
 			if (this->sql_str_.empty())
-				return *this;
+				return self();
 
 			if (this->sql_str_.back() == ';')
 				this->sql_str_.pop_back();
 
 			this->sql_str_ += sql;
 
-			return *this;
+			return self();
+		}
+
+	private:
+		self_type& self()
+		{
+			return static_cast<self_type&>(*this);
 		}
 	};
 
+	template <typename _Ty, string_literal field>
+	struct aggregate_value
+	{
+		using type = double;
+	};
+
+	template <reflect_t _Ty, string_literal field>
+	struct aggregate_value<_Ty, field>
+	{
+		using type = std::remove_cvref_t<tuple_element_t<field_index<_Ty, field>(), _Ty>>;
+	};
+
+	template <typename _Ty, string_literal field>
+	using aggregate_value_t = typename aggregate_value<_Ty, field>::type;
+
+	template <typename _Ty, string_literal field>
+	struct sum_value
+	{
+		using value_type = aggregate_value_t<_Ty, field>;
+
+		using type = std::conditional_t<std::is_integral_v<value_type> && !std::same_as<value_type, bool>, std::int64_t,
+										double>;
+	};
+
+	template <typename _Ty, string_literal field>
+	using sum_value_t = typename sum_value<_Ty, field>::type;
+
 	template <typename _Service>
-	class select_chain : public chain_sql<_Service>
+	class select_chain : public chain_sql<_Service, select_chain<_Service>>
 	{
 	public:
 		explicit select_chain(service_pool<_Service>& pool)
-			: chain_sql<_Service>(pool)
+			: chain_sql<_Service, select_chain<_Service>>(pool)
 		{}
 
 	public:
 		template <typename _From, string_literal... args>
 		select_chain& select()
 		{
+			(field_index<_From, args>(), ...);
+
 			make_select_sql<_From, bind_param<"">::value, bind_param<args>::value...>(this->sql_str_);
 
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <typename _Left, typename _Right, typename _On>
+		select_chain& join(_On&& on)
+		{
+			make_join_sql<_Left, _Right, JOIN>(this->sql_str_);
+
+			mark_table<_Left>();
+
+			on.append(this->sql_str_);
+
+			return *this;
+		}
+
+		template <typename _Left, typename _Right, typename _On>
+		select_chain& left_join(_On&& on)
+		{
+			make_join_sql<_Left, _Right, concat_v<LEFT, SPACE, JOIN>>(this->sql_str_);
+
+			mark_table<_Left>();
+
+			on.append(this->sql_str_);
+
+			return *this;
+		}
+
+		template <typename _From>
+		select_chain& count()
+		{
+			make_aggregate_sql<_From, COUNT, ASTERISK>(this->sql_str_);
+
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <typename _From, string_literal field>
+		select_chain& sum()
+		{
+			field_index<_From, field>();
+
+			make_aggregate_sql<_From, SUM, bind_param<field>::value>(this->sql_str_);
+
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <typename _From, string_literal field>
+		select_chain& min()
+		{
+			field_index<_From, field>();
+
+			make_aggregate_sql<_From, MIN, bind_param<field>::value>(this->sql_str_);
+
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <typename _From, string_literal field>
+		select_chain& max()
+		{
+			field_index<_From, field>();
+
+			make_aggregate_sql<_From, MAX, bind_param<field>::value>(this->sql_str_);
+
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <typename _From>
+		select_chain& exists()
+		{
+			constexpr static auto table_name = name<_From>();
+
+			constexpr auto sql = concat_v<SELECT, SPACE, to_string<1>::value, SPACE, FROM, SPACE, table_name>;
+
+			this->sql_str_ = std::string(sql.data(), sql.size());
+
+			mark_table<_From>();
+
 			return *this;
 		}
 
 		template <typename _From, string_literal... args>
 		select_chain& select_distinct()
 		{
+			(field_index<_From, args>(), ...);
+
 			make_select_sql<_From, concat_v<DISTINCT, SPACE>, bind_param<args>::value...>(this->sql_str_);
 
+			mark_table<_From>(concat_v<SELECT, SPACE, DISTINCT, SPACE>.size());
+
 			return *this;
 		}
 
 		template <typename _From, std::size_t N, string_literal... args>
 		select_chain& select_top()
 		{
+			(field_index<_From, args>(), ...);
+
 			make_select_sql<_From, concat_v<TOP, SPACE, to_string<N>::value, SPACE>, bind_param<args>::value...>(
 				this->sql_str_);
 
+			mark_table<_From>();
+
+			return *this;
+		}
+
+		template <string_literal hint>
+		select_chain& optimizer_hint()
+		{
+			add_hint(bind_param<hint>::value);
+
+			return *this;
+		}
+
+		template <std::size_t milliseconds>
+		select_chain& max_execution_time()
+		{
+			add_hint(concat_v<MAX_EXECUTION_TIME, LEFT_BRACKET, to_string<milliseconds>::value, RIGHT_BRACKET>);
+
+			return *this;
+		}
+
+		select_chain& straight_join()
+		{
+			add_modifier(STRAIGHT_JOIN);
+
+			return *this;
+		}
+
+		select_chain& sql_buffer_result()
+		{
+			add_modifier(SQL_BUFFER_RESULT);
+
+			return *this;
+		}
+
+		template <string_literal... indexes>
+		select_chain& force_index()
+		{
+			add_index_hint<concat_v<SPACE, FORCE, SPACE, INDEX, SPACE, LEFT_BRACKET>, indexes...>();
+
+			return *this;
+		}
+
+		template <string_literal... indexes>
+		select_chain& use_index()
+		{
+			add_index_hint<concat_v<SPACE, USE, SPACE, INDEX, SPACE, LEFT_BRACKET>, indexes...>();
+
+			return *this;
+		}
+
+		template <string_literal... indexes>
+		select_chain& ignore_index()
+		{
+			add_index_hint<concat_v<SPACE, IGNORE, SPACE, INDEX, SPACE, LEFT_BRACKET>, indexes...>();
+
 			return *this;
 		}
 
@@ -225,8 +553,94 @@ namespace aquarius
 		select_chain& having(_Attr&& attr)
 		{
 			this->sql_str_ += " having";
-			this->sql_str_ += attr.sql();
+
+			attr.append(this->sql_str_);
+
 			return *this;
 		}
+
+	private:
+		template <typename _From>
+		void mark_table(std::size_t modifier_pos = SELECT.size() + 1)
+		{
+			this->table_ = name<_From>();
+
+			hint_end_ = 0;
+
+			modifier_pos_ = modifier_pos;
+
+			table_pos_ = this->sql_str_.find(concat_v<SPACE, FROM, SPACE>) + concat_v<SPACE, FROM, SPACE>.size() +
+						 name<_From>().size();
+		}
+
+		void insert_at(std::size_t pos, std::string_view text)
+		{
+			this->sql_str_.insert(pos, text);
+
+			for (auto* mark : { &hint_end_, &modifier_pos_, &table_pos_ })
+			{
+				if (*mark != 0 && *mark >= pos)
+					*mark += text.size();
+			}
+		}
+
+		void add_hint(std::string_view hint)
+		{
+			if (table_pos_ == 0)
+				return;
+
+			if (hint_end_ != 0)
+			{
+				std::string text(SPACE);
+				text += hint;
+
+				insert_at(hint_end_, text);
+
+				return;
+			}
+
+			std::string text(concat_v<SPACE, HINT_BEGIN, SPACE>);
+			text += hint;
+			text += concat_v<SPACE, HINT_END>;
+
+			insert_at(SELECT.size(), text);
+
+			hint_end_ = SELECT.size() + text.size() - concat_v<SPACE, HINT_END>.size();
+		}
+
+		void add_modifier(std::string_view modifier)
+		{
+			if (table_pos_ == 0)
+				return;
+
+			std::string text(modifier);
+			text += SPACE;
+
+			insert_at(modifier_pos_, text);
+		}
+
+		template <const std::string_view& Keyword, string_literal... indexes>
+		void add_index_hint()
+		{
+			static_assert(sizeof...(indexes) != 0, "index hint needs at least one index name!");
+
+			if (table_pos_ == 0)
+				return;
+
+			constexpr auto names = concat_v<concat_v<bind_param<indexes>::value, COMMA, SPACE>...>;
+
+			std::string text(Keyword);
+			text += names.substr(0, names.size() - 2);
+			text += RIGHT_BRACKET;
+
+			insert_at(table_pos_, text);
+		}
+
+	private:
+		std::size_t hint_end_ = 0;
+
+		std::size_t modifier_pos_ = 0;
+
+		std::size_t table_pos_ = 0;
 	};
 } // namespace aquarius
\ No newline at end of file
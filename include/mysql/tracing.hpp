@@ -0,0 +1,209 @@
+#pragma once
+#include <boost/mysql.hpp>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+namespace aquarius
+{
+	namespace span_name
+	{
+		inline constexpr std::string_view query = "mysql.query";
+
+		inline constexpr std::string_view acquire = "mysql.acquire";
+
+		inline constexpr std::string_view build = "mysql.build";
+
+		inline constexpr std::string_view execute = "mysql.execute";
+
+		inline constexpr std::string_view read = "mysql.read";
+
+		inline constexpr std::string_view decode = "mysql.decode";
+	} // namespace span_name
+
+	class trace_span
+	{
+	public:
+		virtual ~trace_span() = default;
+
+	public:
+		virtual void set_attribute(std::string_view key, std::string_view value) = 0;
+
+		virtual void set_attribute(std::string_view key, std::int64_t value) = 0;
+
+		virtual void set_error(std::string_view message) = 0;
+
+		virtual void end() = 0;
+	};
+
+	class tracer
+	{
+	public:
+		virtual ~tracer() = default;
+
+	public:
+		virtual std::unique_ptr<trace_span> start_span(std::string_view name, trace_span* parent,
+													   std::chrono::system_clock::time_point start) = 0;
+	};
+
+	class tracing
+	{
+		struct state
+		{
+			std::atomic<tracer*> active{ nullptr };
+
+			std::mutex mutex;
+
+			std::shared_ptr<tracer> owner;
+
+			std::shared_ptr<tracer> previous;
+		};
+
+	public:
+		static void set_tracer(std::shared_ptr<tracer> value)
+		{
+			auto& s = instance();
+
+			std::lock_guard lk(s.mutex);
+
+			s.active.store(value.get(), std::memory_order_release);
+
+			// the replaced tracer stays alive for one more swap so spans started on it can still end
+			s.previous = std::move(s.owner);
+
+			s.owner = std::move(value);
+		}
+
+		static tracer* get()
+		{
+			return instance().active.load(std::memory_order_acquire);
+		}
+
+		static bool enabled()
+		{
+			return get() != nullptr;
+		}
+
+	private:
+		static state& instance()
+		{
+			static state s{};
+
+			return s;
+		}
+	};
+
+	class scoped_span
+	{
+	public:
+		explicit scoped_span(std::string_view name)
+			: scoped_span(name, current())
+		{}
+
+		scoped_span(std::string_view name, trace_span* parent, std::chrono::system_clock::time_point start = {},
+					bool activate = true)
+		{
+			auto t = tracing::get();
+
+			if (t == nullptr)
+				return;
+
+			if (start == std::chrono::system_clock::time_point{})
+				start = std::chrono::system_clock::now();
+
+			span_ = t->start_span(name, parent, start);
+
+			if (span_ && activate)
+			{
+				previous_ = current();
+
+				active_ = true;
+
+				current_span() = span_.get();
+			}
+		}
+
+		scoped_span(scoped_span&& other) noexcept
+			: span_(std::move(other.span_))
+			, previous_(std::exchange(other.previous_, nullptr))
+			, active_(std::exchange(other.active_, false))
+		{}
+
+		scoped_span(const scoped_span&) = delete;
+
+		scoped_span& operator=(const scoped_span&) = delete;
+
+		~scoped_span()
+		{
+			end();
+
+			if (active_)
+				current_span() = previous_;
+		}
+
+	public:
+		static trace_span* current()
+		{
+			return current_span();
+		}
+
+		explicit operator bool() const
+		{
+			return span_ != nullptr;
+		}
+
+		trace_span* get() const
+		{
+			return span_.get();
+		}
+
+		void set_attribute(std::string_view key, std::string_view value)
+		{
+			if (span_)
+				span_->set_attribute(key, value);
+		}
+
+		template <std::integral _Ty>
+		void set_attribute(std::string_view key, _Ty value)
+		{
+			if (span_)
+				span_->set_attribute(key, static_cast<std::int64_t>(value));
+		}
+
+		void set_error(const boost::mysql::error_code& ec)
+		{
+			if (span_ && ec)
+				span_->set_error(ec.message());
+		}
+
+		void end()
+		{
+			if (!span_)
+				return;
+
+			span_->end();
+
+			span_.reset();
+		}
+
+	private:
+		static trace_span*& current_span()
+		{
+			thread_local trace_span* span = nullptr;
+
+			return span;
+		}
+
+	private:
+		std::unique_ptr<trace_span> span_;
+
+		trace_span* previous_ = nullptr;
+
+		bool active_ = false;
+	};
+} // namespace aquarius
@@ -0,0 +1,344 @@
+#pragma once
+#include <aquarius/mysql.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(mysql_benchmark)
+
+struct bench_products
+{
+	int prod_id;
+	std::string prod_name;
+	int prod_price;
+	int vend_id;
+};
+
+struct bench_pmr_products
+{
+	int prod_id;
+	std::pmr::string prod_name;
+	int prod_price;
+	int vend_id;
+};
+
+struct bench_wide
+{
+	int64_t c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11, c12, c13, c14, c15;
+	int64_t c16, c17, c18, c19, c20, c21, c22, c23, c24, c25, c26, c27, c28, c29, c30, c31;
+	int64_t c32, c33, c34, c35, c36, c37, c38, c39, c40, c41, c42, c43, c44, c45, c46, c47;
+	int64_t c48, c49, c50, c51, c52, c53, c54, c55, c56, c57, c58, c59, c60, c61, c62, c63;
+	int64_t c64, c65, c66, c67, c68, c69, c70, c71, c72, c73, c74, c75, c76, c77, c78, c79;
+	int64_t c80, c81, c82, c83, c84, c85, c86, c87, c88, c89, c90, c91, c92, c93, c94, c95;
+	int64_t c96, c97, c98, c99, c100, c101, c102, c103, c104, c105, c106, c107, c108, c109, c110, c111;
+	int64_t c112, c113, c114, c115, c116, c117, c118, c119, c120, c121, c122, c123, c124, c125, c126, c127;
+};
+
+constexpr std::size_t bench_rows = 50000;
+
+constexpr std::size_t bench_wide_rows = 10000;
+
+constexpr std::size_t bench_wide_passes = 20;
+
+struct bench_table
+{
+	std::vector<std::string> names;
+
+	std::vector<std::vector<boost::mysql::field_view>> rows;
+};
+
+inline bench_table make_bench_table(std::size_t rows)
+{
+	bench_table table{};
+
+	table.names.reserve(rows);
+	table.rows.reserve(rows);
+
+	for (std::size_t i = 0; i < rows; ++i)
+	{
+		table.names.push_back("product_name_outside_sso_" + std::to_string(i));
+
+		table.rows.push_back({ boost::mysql::field_view(static_cast<int64_t>(i)),
+							   boost::mysql::field_view(std::string_view(table.names.back())),
+							   boost::mysql::field_view(static_cast<int64_t>(i % 100)),
+							   boost::mysql::field_view(static_cast<int64_t>(i % 7)) });
+	}
+
+	return table;
+}
+
+inline std::vector<std::vector<boost::mysql::field_view>> make_bench_wide_table(std::size_t rows)
+{
+	std::vector<std::vector<boost::mysql::field_view>> table{};
+
+	table.reserve(rows);
+
+	for (std::size_t i = 0; i < rows; ++i)
+	{
+		auto& row = table.emplace_back();
+
+		row.reserve(aquarius::tuple_size_v<bench_wide>);
+
+		for (std::size_t j = 0; j < aquarius::tuple_size_v<bench_wide>; ++j)
+		{
+			row.emplace_back(static_cast<int64_t>(i + j));
+		}
+	}
+
+	return table;
+}
+
+template <std::size_t... I>
+int64_t bench_sum_get(const bench_wide& value, std::index_sequence<I...>)
+{
+	auto fields = aquarius::tie_fields(value);
+
+	return (aquarius::get<I>(fields) + ...);
+}
+
+template <typename _Func>
+double bench_ns(std::size_t iterations, _Func&& f)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < iterations; ++i)
+	{
+		f();
+	}
+
+	auto elapse = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+	return static_cast<double>(elapse.count()) / iterations;
+}
+
+inline void bench_report(std::string_view name, double ns_per_op, std::size_t items_per_op)
+{
+	std::cout << "{\"benchmark\":\"" << name << "\",\"ns_per_op\":" << ns_per_op
+			  << ",\"items_per_sec\":" << (ns_per_op > 0 ? items_per_op * 1e9 / ns_per_op : 0) << "}" << std::endl;
+}
+
+class bench_service
+{
+public:
+	template <typename _Endpoint, typename _Param>
+	bench_service(boost::asio::io_service&, _Endpoint&&, _Param&&)
+	{}
+
+public:
+	static inline std::chrono::microseconds latency{};
+
+	void close()
+	{}
+
+	bool execute(const std::string&, boost::mysql::error_code&)
+	{
+		if (latency.count() > 0)
+			std::this_thread::sleep_for(latency);
+
+		return true;
+	}
+};
+
+BOOST_AUTO_TEST_CASE(decode_vector_vs_pmr)
+{
+	auto table = make_bench_table(bench_rows);
+
+	std::size_t vector_rows = 0;
+
+	auto vector_ns = bench_ns(20,
+							  [&]
+							  {
+								  std::vector<bench_products> result{};
+
+								  for (const auto& row : table.rows)
+								  {
+									  result.push_back(aquarius::to_struct<bench_products>(row));
+								  }
+
+								  vector_rows = result.size();
+							  });
+
+	std::size_t pmr_rows = 0;
+
+	auto pmr_ns = bench_ns(20,
+						   [&]
+						   {
+							   auto result = aquarius::make_pmr_result<bench_pmr_products>(table.rows);
+
+							   pmr_rows = result.size();
+						   });
+
+	BOOST_CHECK_EQUAL(vector_rows, bench_rows);
+	BOOST_CHECK_EQUAL(pmr_rows, bench_rows);
+
+	bench_report("decode_vector", vector_ns, bench_rows);
+	bench_report("decode_pmr", pmr_ns, bench_rows);
+}
+
+BOOST_AUTO_TEST_CASE(wide_table_reflection)
+{
+	static_assert(aquarius::tuple_size_v<bench_wide> == 128);
+
+	auto table = make_bench_wide_table(bench_wide_rows);
+
+	std::vector<bench_wide> result{};
+
+	result.reserve(bench_wide_rows);
+
+	auto decode_ns = bench_ns(bench_wide_passes,
+							  [&]
+							  {
+								  result.clear();
+
+								  for (const auto& row : table)
+								  {
+									  result.push_back(aquarius::to_struct<bench_wide>(row));
+								  }
+							  });
+
+	BOOST_CHECK_EQUAL(result.size(), bench_wide_rows);
+	BOOST_CHECK_EQUAL(result.back().c127, static_cast<int64_t>(bench_wide_rows - 1 + 127));
+
+	int64_t get_sum = 0;
+
+	auto get_ns = bench_ns(bench_wide_passes,
+						   [&]
+						   {
+							   for (const auto& value : result)
+							   {
+								   get_sum += bench_sum_get(value, std::make_index_sequence<128>{});
+							   }
+						   });
+
+	int64_t tie_sum = 0;
+
+	auto tie_ns = bench_ns(bench_wide_passes,
+						   [&]
+						   {
+							   for (const auto& value : result)
+							   {
+								   aquarius::for_each(value, [&](auto field) { tie_sum += field; });
+							   }
+						   });
+
+	BOOST_CHECK_EQUAL(get_sum, tie_sum);
+
+	bench_report("decode_wide_128", decode_ns, bench_wide_rows);
+	bench_report("field_access_get_128", get_ns, bench_wide_rows * 128);
+	bench_report("field_access_tie_128", tie_ns, bench_wide_rows * 128);
+}
+
+BOOST_AUTO_TEST_CASE(sql_generation)
+{
+	constexpr std::size_t iterations = 200000;
+
+	std::string sql{};
+
+	sql.reserve(256);
+
+	auto select_ns = bench_ns(iterations,
+							  [&]
+							  {
+								  sql.clear();
+
+								  aquarius::make_select_sql<bench_products, aquarius::bind_param<"">::value>(sql);
+							  });
+
+	BOOST_CHECK(!sql.empty());
+
+	bench_products product{ 1, "product_name_outside_sso", 100, 7 };
+
+	auto insert_ns = bench_ns(iterations,
+							  [&]
+							  {
+								  sql.clear();
+
+								  aquarius::make_input_sql<aquarius::INSERT>(sql, product);
+							  });
+
+	BOOST_CHECK(!sql.empty());
+
+	int value = 0;
+
+	auto expression_ns = bench_ns(iterations,
+								  [&]
+								  {
+									  sql.clear();
+
+									  (AQUARIUS_EXPR(prod_id) == ++value &
+									   (AQUARIUS_EXPR(prod_name).like("c%") | AQUARIUS_EXPR(vend_id).in(1, 2, 3)))
+										  .append(sql);
+								  });
+
+	BOOST_CHECK(!sql.empty());
+
+	bench_report("make_select_sql", select_ns, 1);
+	bench_report("make_input_sql", insert_ns, 1);
+	bench_report("attributes_expression", expression_ns, 1);
+}
+
+BOOST_AUTO_TEST_CASE(pool_contention)
+{
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<bench_service> pool(io_pool, "127.0.0.1", boost::mysql::default_port_string, "bench",
+											   "bench", "bench");
+
+	pool.enable_priority({ pool.capacity(), 0, pool.capacity() });
+
+	for (auto latency : { std::chrono::microseconds(0), std::chrono::microseconds(50) })
+	{
+		bench_service::latency = latency;
+
+		const std::size_t operations = latency.count() == 0 ? 20000 : 200;
+
+		for (std::size_t threads = 1; threads <= 64; threads *= 2)
+		{
+			pool.metrics().reset();
+
+			std::vector<std::thread> workers{};
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (std::size_t i = 0; i < threads; ++i)
+			{
+				workers.emplace_back(
+					[&]
+					{
+						for (std::size_t n = 0; n < operations; ++n)
+						{
+							pool.execute("select 1");
+						}
+					});
+			}
+
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+
+			auto elapse = aquarius::elapsed_ns(start);
+
+			auto snapshot = pool.snapshot();
+
+			BOOST_CHECK_EQUAL(snapshot.queries, threads * operations);
+
+			std::cout << "{\"benchmark\":\"pool_execute\",\"threads\":" << threads
+					  << ",\"latency_us\":" << latency.count()
+					  << ",\"ns_per_op\":" << static_cast<double>(elapse) / (threads * operations)
+					  << ",\"ops_per_sec\":" << threads * operations * 1e9 / static_cast<double>(elapse)
+					  << ",\"acquire_p99_ns\":" << snapshot.acquire_wait.p99
+					  << ",\"connections\":" << snapshot.connections_created << "}" << std::endl;
+		}
+	}
+
+	BOOST_CHECK_EQUAL(pool.snapshot().connections_created, pool.capacity());
+
+	pool.stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,1561 @@
+#pragma once
+#include <aquarius/mysql/algorithm.hpp>
+#include <aquarius/mysql/slow_log.hpp>
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aquarius
+{
+	enum class stand_in_type
+	{
+		integer,
+		floating,
+		text,
+		datetime
+	};
+
+	struct stand_in_column
+	{
+		std::string name;
+
+		stand_in_type type = stand_in_type::text;
+	};
+
+	struct stand_in_result
+	{
+		std::string table;
+
+		std::vector<stand_in_column> columns;
+
+		std::vector<std::vector<std::optional<std::string>>> rows;
+
+		std::uint64_t affected_rows = 0;
+
+		std::uint64_t last_insert_id = 0;
+
+		std::uint16_t error_code = 0;
+
+		std::string sql_state = "HY000";
+
+		std::string error_message;
+	};
+
+	struct stand_in_options
+	{
+		std::chrono::microseconds latency{ 0 };
+
+		std::chrono::microseconds jitter{ 0 };
+
+		double error_rate = 0;
+
+		std::uint16_t injected_error = 1213;
+
+		double disconnect_rate = 0;
+
+		double truncate_rate = 0;
+
+		std::uint32_t seed = 1;
+	};
+
+	inline stand_in_result generate_table(std::string table, std::vector<stand_in_column> columns, std::size_t rows)
+	{
+		stand_in_result result{};
+
+		result.table = std::move(table);
+		result.columns = std::move(columns);
+		result.rows.reserve(rows);
+
+		for (std::size_t r = 0; r < rows; ++r)
+		{
+			auto& row = result.rows.emplace_back();
+
+			row.reserve(result.columns.size());
+
+			for (std::size_t c = 0; c < result.columns.size(); ++c)
+			{
+				const auto& column = result.columns[c];
+
+				switch (column.type)
+				{
+				case stand_in_type::integer:
+					row.emplace_back(std::to_string(c == 0 ? r : (r * 7 + c) % 1000));
+					break;
+				case stand_in_type::floating:
+					row.emplace_back(std::to_string(r % 100) + ".5");
+					break;
+				case stand_in_type::text:
+					row.emplace_back(column.name + "_" + std::to_string(r));
+					break;
+				case stand_in_type::datetime:
+				{
+					char buffer[32]{};
+
+					std::snprintf(buffer, sizeof(buffer), "2024-01-01 %02zu:%02zu:%02zu", (r / 3600) % 24, (r / 60) % 60,
+								  r % 60);
+
+					row.emplace_back(buffer);
+				}
+				break;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	namespace detail
+	{
+		namespace wire
+		{
+			inline constexpr std::uint32_t long_password = 0x1;
+			inline constexpr std::uint32_t found_rows = 0x2;
+			inline constexpr std::uint32_t long_flag = 0x4;
+			inline constexpr std::uint32_t connect_with_db = 0x8;
+			inline constexpr std::uint32_t protocol_41 = 0x200;
+			inline constexpr std::uint32_t transactions = 0x2000;
+			inline constexpr std::uint32_t secure_connection = 0x8000;
+			inline constexpr std::uint32_t multi_statements = 0x10000;
+			inline constexpr std::uint32_t multi_results = 0x20000;
+			inline constexpr std::uint32_t ps_multi_results = 0x40000;
+			inline constexpr std::uint32_t plugin_auth = 0x80000;
+			inline constexpr std::uint32_t connect_attrs = 0x100000;
+			inline constexpr std::uint32_t plugin_auth_lenenc_data = 0x200000;
+			inline constexpr std::uint32_t deprecate_eof = 0x1000000;
+
+			inline constexpr std::uint32_t server_capabilities =
+				long_password | found_rows | long_flag | connect_with_db | protocol_41 | transactions |
+				secure_connection | multi_statements | multi_results | ps_multi_results | plugin_auth | connect_attrs |
+				plugin_auth_lenenc_data | deprecate_eof;
+
+			inline constexpr std::uint16_t status_autocommit = 0x2;
+
+			inline constexpr std::uint8_t com_quit = 0x01;
+			inline constexpr std::uint8_t com_init_db = 0x02;
+			inline constexpr std::uint8_t com_query = 0x03;
+			inline constexpr std::uint8_t com_ping = 0x0e;
+			inline constexpr std::uint8_t com_stmt_prepare = 0x16;
+			inline constexpr std::uint8_t com_stmt_execute = 0x17;
+			inline constexpr std::uint8_t com_stmt_close = 0x19;
+			inline constexpr std::uint8_t com_stmt_reset = 0x1a;
+			inline constexpr std::uint8_t com_reset_connection = 0x1f;
+
+			inline constexpr std::uint8_t type_decimal = 0x00;
+			inline constexpr std::uint8_t type_tiny = 0x01;
+			inline constexpr std::uint8_t type_short = 0x02;
+			inline constexpr std::uint8_t type_long = 0x03;
+			inline constexpr std::uint8_t type_float = 0x04;
+			inline constexpr std::uint8_t type_double = 0x05;
+			inline constexpr std::uint8_t type_null = 0x06;
+			inline constexpr std::uint8_t type_timestamp = 0x07;
+			inline constexpr std::uint8_t type_longlong = 0x08;
+			inline constexpr std::uint8_t type_int24 = 0x09;
+			inline constexpr std::uint8_t type_date = 0x0a;
+			inline constexpr std::uint8_t type_time = 0x0b;
+			inline constexpr std::uint8_t type_datetime = 0x0c;
+			inline constexpr std::uint8_t type_year = 0x0d;
+			inline constexpr std::uint8_t type_var_string = 0xfd;
+
+			inline constexpr std::uint16_t collation_utf8mb4 = 45;
+			inline constexpr std::uint16_t collation_binary = 63;
+		} // namespace wire
+
+		inline void put_int(std::string& out, std::uint64_t value, std::size_t bytes)
+		{
+			for (std::size_t i = 0; i < bytes; ++i)
+			{
+				out += static_cast<char>((value >> (8 * i)) & 0xff);
+			}
+		}
+
+		inline void put_lenenc(std::string& out, std::uint64_t value)
+		{
+			if (value < 251)
+			{
+				put_int(out, value, 1);
+			}
+			else if (value < (1ull << 16))
+			{
+				out += static_cast<char>(0xfc);
+				put_int(out, value, 2);
+			}
+			else if (value < (1ull << 24))
+			{
+				out += static_cast<char>(0xfd);
+				put_int(out, value, 3);
+			}
+			else
+			{
+				out += static_cast<char>(0xfe);
+				put_int(out, value, 8);
+			}
+		}
+
+		inline void put_lenenc_str(std::string& out, std::string_view value)
+		{
+			put_lenenc(out, value.size());
+
+			out += value;
+		}
+
+		class wire_reader
+		{
+		public:
+			explicit wire_reader(std::string_view data)
+				: data_(data)
+			{}
+
+		public:
+			bool empty() const
+			{
+				return pos_ >= data_.size();
+			}
+
+			std::uint64_t get_int(std::size_t bytes)
+			{
+				std::uint64_t value = 0;
+
+				for (std::size_t i = 0; i < bytes && pos_ < data_.size(); ++i)
+				{
+					value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data_[pos_++])) << (8 * i);
+				}
+
+				return value;
+			}
+
+			std::uint64_t get_lenenc()
+			{
+				auto first = get_int(1);
+
+				switch (first)
+				{
+				case 0xfc:
+					return get_int(2);
+				case 0xfd:
+					return get_int(3);
+				case 0xfe:
+					return get_int(8);
+				default:
+					return first;
+				}
+			}
+
+			std::string_view get_bytes(std::size_t size)
+			{
+				auto value = data_.substr(std::min(pos_, data_.size()), size);
+
+				pos_ += value.size();
+
+				return value;
+			}
+
+			std::string_view get_lenenc_str()
+			{
+				return get_bytes(static_cast<std::size_t>(get_lenenc()));
+			}
+
+		private:
+			std::string_view data_;
+
+			std::size_t pos_ = 0;
+		};
+
+		inline std::string_view trim_statement(std::string_view sql)
+		{
+			while (!sql.empty() && (std::isspace(static_cast<unsigned char>(sql.back())) || sql.back() == ';'))
+			{
+				sql.remove_suffix(1);
+			}
+
+			while (!sql.empty() && std::isspace(static_cast<unsigned char>(sql.front())))
+			{
+				sql.remove_prefix(1);
+			}
+
+			return sql;
+		}
+
+		inline std::size_t count_placeholders(std::string_view sql)
+		{
+			std::size_t count = 0;
+
+			for (std::size_t pos = 0; pos < sql.size();)
+			{
+				if (sql[pos] == '\'' || sql[pos] == '"')
+				{
+					pos = skip_quoted(sql, pos);
+
+					continue;
+				}
+
+				if (sql[pos] == '?')
+					++count;
+
+				++pos;
+			}
+
+			return count;
+		}
+
+		inline bool starts_with_word(std::string_view sql, std::string_view word)
+		{
+			if (sql.size() < word.size())
+				return false;
+
+			for (std::size_t i = 0; i < word.size(); ++i)
+			{
+				if (std::tolower(static_cast<unsigned char>(sql[i])) != word[i])
+					return false;
+			}
+
+			return sql.size() == word.size() || !is_identifier_char(sql[word.size()]);
+		}
+
+		inline std::size_t find_word(std::string_view sql, std::string_view word)
+		{
+			for (std::size_t pos = 0; pos + word.size() <= sql.size(); ++pos)
+			{
+				if ((pos == 0 || !is_identifier_char(sql[pos - 1])) && starts_with_word(sql.substr(pos), word))
+					return pos;
+			}
+
+			return std::string_view::npos;
+		}
+
+		inline std::string_view next_identifier(std::string_view sql)
+		{
+			auto begin = sql.find_first_not_of(' ');
+
+			if (begin == std::string_view::npos)
+				return {};
+
+			sql.remove_prefix(begin);
+
+			std::size_t end = 0;
+
+			while (end < sql.size() && (is_identifier_char(sql[end]) || sql[end] == '`' || sql[end] == '.'))
+			{
+				++end;
+			}
+
+			auto name = sql.substr(0, end);
+
+			if (auto dot = name.rfind('.'); dot != std::string_view::npos)
+				name.remove_prefix(dot + 1);
+
+			while (!name.empty() && name.front() == '`')
+				name.remove_prefix(1);
+
+			while (!name.empty() && name.back() == '`')
+				name.remove_suffix(1);
+
+			return name;
+		}
+
+		inline std::string_view next_token(std::string_view& sql)
+		{
+			auto begin = sql.find_first_not_of(' ');
+
+			if (begin == std::string_view::npos)
+			{
+				sql = {};
+
+				return {};
+			}
+
+			sql.remove_prefix(begin);
+
+			auto end = std::min(sql.find(' '), sql.size());
+
+			auto token = sql.substr(0, end);
+
+			sql.remove_prefix(end);
+
+			return token;
+		}
+
+		inline bool parse_integer(std::string_view text, std::int64_t& value)
+		{
+			auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+			return ec == std::errc{} && ptr == text.data() + text.size();
+		}
+
+		inline bool parse_range(std::string_view condition, std::string_view& column, std::int64_t& low,
+								std::int64_t& high)
+		{
+			column = next_identifier(next_token(condition));
+
+			auto op = next_token(condition);
+
+			if (column.empty() || !parse_integer(next_token(condition), low))
+				return false;
+
+			if (op == "=")
+			{
+				high = low;
+			}
+			else if (op == ">=")
+			{
+				if (!starts_with_word(next_token(condition), "and") ||
+					next_identifier(next_token(condition)) != column || next_token(condition) != "<=" ||
+					!parse_integer(next_token(condition), high))
+					return false;
+			}
+			else if (!starts_with_word(op, "between") || !starts_with_word(next_token(condition), "and") ||
+					 !parse_integer(next_token(condition), high))
+			{
+				return false;
+			}
+
+			return trim_statement(condition).empty();
+		}
+
+		inline bool parse_clauses(std::string_view clauses, std::string_view& condition, std::string_view& order,
+								  std::int64_t& limit, std::int64_t& offset)
+		{
+			clauses = trim_statement(clauses);
+
+			if (starts_with_word(clauses, "where"))
+			{
+				auto stop = std::min({ find_word(clauses, "order"), find_word(clauses, "limit"), clauses.size() });
+
+				condition = trim_statement(clauses.substr(5, stop - 5));
+
+				clauses.remove_prefix(stop);
+
+				if (condition.empty())
+					return false;
+			}
+
+			if (starts_with_word(clauses, "order"))
+			{
+				clauses.remove_prefix(5);
+
+				if (!starts_with_word(next_token(clauses), "by"))
+					return false;
+
+				auto stop = std::min(find_word(clauses, "limit"), clauses.size());
+
+				order = trim_statement(clauses.substr(0, stop));
+
+				clauses.remove_prefix(stop);
+
+				if (order.empty())
+					return false;
+			}
+
+			if (starts_with_word(clauses, "limit"))
+			{
+				clauses.remove_prefix(5);
+
+				if (!parse_integer(next_token(clauses), limit) || limit < 0)
+					return false;
+
+				clauses = trim_statement(clauses);
+
+				if (starts_with_word(clauses, "offset"))
+				{
+					clauses.remove_prefix(6);
+
+					if (!parse_integer(next_token(clauses), offset) || offset < 0)
+						return false;
+				}
+			}
+
+			return trim_statement(clauses).empty();
+		}
+
+		inline bool parse_datetime(std::string_view text, int (&parts)[7])
+		{
+			std::fill(std::begin(parts), std::end(parts), 0);
+
+			std::size_t index = 0;
+
+			for (std::size_t pos = 0; pos < text.size() && index < 7;)
+			{
+				if (!std::isdigit(static_cast<unsigned char>(text[pos])))
+				{
+					++pos;
+
+					continue;
+				}
+
+				auto begin = pos;
+
+				while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])))
+				{
+					++pos;
+				}
+
+				auto digits = text.substr(begin, pos - begin);
+
+				auto value = 0;
+
+				std::from_chars(digits.data(), digits.data() + digits.size(), value);
+
+				if (index == 6)
+				{
+					for (auto n = digits.size(); n < 6; ++n)
+					{
+						value *= 10;
+					}
+				}
+
+				parts[index++] = value;
+			}
+
+			return index >= 3;
+		}
+	} // namespace detail
+
+	class stand_in_server
+	{
+		class session;
+
+		struct prepared
+		{
+			std::string sql;
+
+			std::size_t params = 0;
+
+			std::vector<std::uint8_t> types;
+		};
+
+	public:
+		using handler_type = std::function<std::shared_ptr<const stand_in_result>(std::string_view)>;
+
+	public:
+		explicit stand_in_server(boost::asio::io_service& ios, stand_in_options options = {},
+								 unsigned short port = 0)
+			: acceptor_(ios, boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), port))
+			, options_(options)
+		{}
+
+		~stand_in_server()
+		{
+			stop();
+		}
+
+	public:
+		unsigned short port() const
+		{
+			return acceptor_.local_endpoint().port();
+		}
+
+		void add_table(stand_in_result table)
+		{
+			std::lock_guard lk(mutex_);
+
+			auto name = table.table;
+
+			tables_[name] = std::make_shared<const stand_in_result>(std::move(table));
+		}
+
+		void set_handler(handler_type handler)
+		{
+			std::lock_guard lk(mutex_);
+
+			handler_ = std::move(handler);
+		}
+
+		void start()
+		{
+			accept();
+		}
+
+		void stop()
+		{
+			boost::system::error_code ec;
+
+			acceptor_.close(ec);
+		}
+
+		std::uint64_t connections() const
+		{
+			return connections_.load(std::memory_order_relaxed);
+		}
+
+		std::uint64_t commands() const
+		{
+			return commands_.load(std::memory_order_relaxed);
+		}
+
+		std::shared_ptr<const stand_in_result> handle(std::string_view sql)
+		{
+			handler_type handler{};
+
+			{
+				std::lock_guard lk(mutex_);
+
+				handler = handler_;
+			}
+
+			if (handler)
+			{
+				auto result = handler(sql);
+
+				if (result)
+					return result;
+			}
+
+			return route(detail::trim_statement(sql));
+		}
+
+	private:
+		std::shared_ptr<const stand_in_result> route(std::string_view sql)
+		{
+			auto result = std::make_shared<stand_in_result>();
+
+			if (detail::starts_with_word(sql, "select"))
+			{
+				auto from = detail::find_word(sql, "from");
+
+				if (from == std::string_view::npos)
+				{
+					result->columns.push_back({ std::string(detail::trim_statement(sql.substr(6))),
+												stand_in_type::integer });
+					result->rows.push_back({ std::string("1") });
+
+					return result;
+				}
+
+				auto clauses = sql.substr(from + 4);
+
+				auto name = std::string(detail::next_identifier(detail::next_token(clauses)));
+
+				std::shared_ptr<const stand_in_result> table{};
+
+				{
+					std::lock_guard lk(mutex_);
+
+					auto iter = tables_.find(name);
+
+					if (iter != tables_.end())
+						table = iter->second;
+				}
+
+				if (!table)
+					return error(1146, "42S02", "Table '" + name + "' doesn't exist");
+
+				std::string_view condition{};
+
+				std::string_view order{};
+
+				std::int64_t limit = -1;
+
+				std::int64_t offset = 0;
+
+				if (!detail::parse_clauses(clauses, condition, order, limit, offset))
+					return error(1235, "42000", "stand-in server can't route '" + std::string(sql) + "'");
+
+				if (!condition.empty())
+				{
+					table = filter(table, condition);
+
+					if (table->error_code != 0)
+						return table;
+				}
+
+				if (!order.empty() || limit >= 0 || offset > 0)
+				{
+					table = arrange(table, order, limit, offset);
+
+					if (table->error_code != 0)
+						return table;
+				}
+
+				auto select_list = detail::trim_statement(sql.substr(6, from - 6));
+
+				if (detail::find_word(select_list, "count") == 0)
+				{
+					result->table = table->table;
+					result->columns.push_back({ std::string(select_list), stand_in_type::integer });
+					result->rows.push_back({ std::to_string(table->rows.size()) });
+
+					return result;
+				}
+
+				return project(table, select_list);
+			}
+
+			if (detail::starts_with_word(sql, "insert") || detail::starts_with_word(sql, "replace"))
+			{
+				result->affected_rows = 1;
+				result->last_insert_id = ++insert_id_;
+			}
+			else if (detail::starts_with_word(sql, "update") || detail::starts_with_word(sql, "delete"))
+			{
+				result->affected_rows = 1;
+			}
+
+			return result;
+		}
+
+		static std::shared_ptr<const stand_in_result> error(std::uint16_t code, std::string state,
+															std::string message)
+		{
+			auto result = std::make_shared<stand_in_result>();
+
+			result->error_code = code;
+			result->sql_state = std::move(state);
+			result->error_message = std::move(message);
+
+			return result;
+		}
+
+		static std::size_t find_column(const stand_in_result& table, std::string_view name)
+		{
+			auto iter = std::find_if(table.columns.begin(), table.columns.end(),
+									 [&](const auto& item) { return detail::iequals(item.name, name); });
+
+			return static_cast<std::size_t>(iter - table.columns.begin());
+		}
+
+		static std::shared_ptr<const stand_in_result> filter(std::shared_ptr<const stand_in_result> table,
+															 std::string_view condition)
+		{
+			std::string_view column{};
+
+			std::int64_t low = 0;
+
+			std::int64_t high = 0;
+
+			if (!detail::parse_range(condition, column, low, high))
+				return error(1235, "42000", "stand-in server can't filter on '" + std::string(condition) + "'");
+
+			auto index = find_column(*table, column);
+
+			if (index == table->columns.size())
+				return error(1054, "42S22", "Unknown column '" + std::string(column) + "' in 'where clause'");
+
+			if (table->columns[index].type != stand_in_type::integer)
+				return error(1235, "42000", "stand-in server can't filter on non-integer column '" +
+												std::string(column) + "'");
+
+			auto result = std::make_shared<stand_in_result>();
+
+			result->table = table->table;
+			result->columns = table->columns;
+
+			for (const auto& row : table->rows)
+			{
+				std::int64_t value = 0;
+
+				if (row[index] && detail::parse_integer(*row[index], value) && value >= low && value <= high)
+					result->rows.push_back(row);
+			}
+
+			return result;
+		}
+
+		static std::shared_ptr<const stand_in_result> arrange(std::shared_ptr<const stand_in_result> table,
+															  std::string_view order, std::int64_t limit, std::int64_t offset)
+		{
+			auto result = std::make_shared<stand_in_result>(*table);
+
+			if (!order.empty())
+			{
+				if (order.find_first_of(", ") != std::string_view::npos ||
+					std::isdigit(static_cast<unsigned char>(order.front())))
+					return error(1235, "42000", "stand-in server can't order by '" + std::string(order) + "'");
+
+				auto index = find_column(*table, order);
+
+				if (index == table->columns.size())
+					return error(1054, "42S22", "Unknown column '" + std::string(order) + "' in 'order clause'");
+
+				auto numeric = table->columns[index].type == stand_in_type::integer;
+
+				std::stable_sort(result->rows.begin(), result->rows.end(),
+								 [&](const auto& lhs, const auto& rhs)
+								 {
+									 if (!lhs[index] || !rhs[index])
+										 return !lhs[index] && rhs[index];
+
+									 std::int64_t left = 0;
+
+									 std::int64_t right = 0;
+
+									 if (numeric && detail::parse_integer(*lhs[index], left) &&
+										 detail::parse_integer(*rhs[index], right))
+										 return left < right;
+
+									 return *lhs[index] < *rhs[index];
+								 });
+			}
+
+			auto skip = std::min(static_cast<std::size_t>(offset), result->rows.size());
+
+			result->rows.erase(result->rows.begin(), result->rows.begin() + skip);
+
+			if (limit >= 0 && static_cast<std::size_t>(limit) < result->rows.size())
+				result->rows.resize(static_cast<std::size_t>(limit));
+
+			return result;
+		}
+
+		static std::shared_ptr<const stand_in_result> project(std::shared_ptr<const stand_in_result> table,
+															  std::string_view select_list)
+		{
+			if (select_list == "*")
+				return table;
+
+			std::vector<std::size_t> indexes{};
+
+			auto result = std::make_shared<stand_in_result>();
+
+			result->table = table->table;
+
+			while (!select_list.empty())
+			{
+				auto comma = std::min(select_list.find(','), select_list.size());
+
+				auto item = detail::trim_statement(select_list.substr(0, comma));
+
+				select_list.remove_prefix(std::min(comma + 1, select_list.size()));
+
+				std::int64_t value = 0;
+
+				if (detail::parse_integer(item, value))
+				{
+					indexes.push_back(table->columns.size());
+
+					result->columns.push_back({ std::string(item), stand_in_type::integer });
+
+					continue;
+				}
+
+				auto name = detail::next_identifier(item);
+
+				if (name.empty() || !std::all_of(item.begin(), item.end(), [](char c)
+												 { return detail::is_identifier_char(c) || c == '`' || c == '.'; }))
+					return error(1235, "42000", "stand-in server can't select '" + std::string(item) + "'");
+
+				auto index = find_column(*table, name);
+
+				if (index == table->columns.size())
+					return error(1054, "42S22", "Unknown column '" + std::string(name) + "' in 'field list'");
+
+				indexes.push_back(index);
+
+				result->columns.push_back(table->columns[index]);
+			}
+
+			result->rows.reserve(table->rows.size());
+
+			for (const auto& row : table->rows)
+			{
+				auto& projected = result->rows.emplace_back();
+
+				projected.reserve(indexes.size());
+
+				for (std::size_t i = 0; i < indexes.size(); ++i)
+				{
+					if (indexes[i] < row.size())
+						projected.push_back(row[indexes[i]]);
+					else
+						projected.push_back(result->columns[i].name);
+				}
+			}
+
+			return result;
+		}
+
+		void accept();
+
+	private:
+		boost::asio::ip::tcp::acceptor acceptor_;
+
+		stand_in_options options_;
+
+		std::mutex mutex_;
+
+		std::unordered_map<std::string, std::shared_ptr<const stand_in_result>> tables_;
+
+		handler_type handler_;
+
+		std::atomic<std::uint64_t> connections_{ 0 };
+
+		std::atomic<std::uint64_t> commands_{ 0 };
+
+		std::atomic<std::uint64_t> insert_id_{ 0 };
+	};
+
+	class stand_in_server::session : public std::enable_shared_from_this<session>
+	{
+	public:
+		session(stand_in_server& server, boost::asio::ip::tcp::socket socket, std::uint32_t id)
+			: server_(server)
+			, socket_(std::move(socket))
+			, timer_(socket_.get_executor())
+			, id_(id)
+			, random_(server.options_.seed + id)
+		{}
+
+	public:
+		void start()
+		{
+			std::string out{};
+
+			write_handshake(out);
+
+			write(std::move(out));
+		}
+
+	private:
+		void read()
+		{
+			boost::asio::async_read(socket_, boost::asio::buffer(header_),
+									[self = shared_from_this()](const boost::system::error_code& ec, std::size_t)
+									{
+										if (ec)
+											return;
+
+										self->read_payload();
+									});
+		}
+
+		void read_payload()
+		{
+			auto size = static_cast<std::size_t>(header_[0]) | static_cast<std::size_t>(header_[1]) << 8 |
+						static_cast<std::size_t>(header_[2]) << 16;
+
+			seq_ = static_cast<std::uint8_t>(header_[3] + 1);
+
+			payload_.resize(size);
+
+			boost::asio::async_read(socket_, boost::asio::buffer(payload_),
+									[self = shared_from_this()](const boost::system::error_code& ec, std::size_t)
+									{
+										if (ec)
+											return;
+
+										self->dispatch();
+									});
+		}
+
+		void dispatch()
+		{
+			std::string out{};
+
+			if (!authenticated_)
+			{
+				detail::wire_reader reader(payload_);
+
+				client_capabilities_ = static_cast<std::uint32_t>(reader.get_int(4));
+
+				authenticated_ = true;
+
+				write_ok(out, 0, 0);
+
+				write(std::move(out));
+
+				return;
+			}
+
+			if (payload_.empty() || static_cast<std::uint8_t>(payload_[0]) == detail::wire::com_quit)
+				return close();
+
+			auto command = static_cast<std::uint8_t>(payload_[0]);
+
+			auto body = std::string_view(payload_).substr(1);
+
+			if (command == detail::wire::com_stmt_close)
+			{
+				statements_.erase(static_cast<std::uint32_t>(detail::wire_reader(body).get_int(4)));
+
+				return read();
+			}
+
+			server_.commands_.fetch_add(1, std::memory_order_relaxed);
+
+			if (roll(server_.options_.disconnect_rate))
+				return close();
+
+			if (roll(server_.options_.error_rate))
+			{
+				write_error(out, server_.options_.injected_error, "40001", "Injected error from stand-in server");
+			}
+			else
+			{
+				switch (command)
+				{
+				case detail::wire::com_query:
+					write_result(out, *server_.handle(body), false);
+					break;
+				case detail::wire::com_stmt_prepare:
+					write_prepare(out, body);
+					break;
+				case detail::wire::com_stmt_execute:
+					write_execute(out, body);
+					break;
+				case detail::wire::com_reset_connection:
+					statements_.clear();
+					write_ok(out, 0, 0);
+					break;
+				case detail::wire::com_ping:
+				case detail::wire::com_init_db:
+				case detail::wire::com_stmt_reset:
+					write_ok(out, 0, 0);
+					break;
+				default:
+					write_error(out, 1047, "08S01", "Unknown command");
+					break;
+				}
+			}
+
+			if (command == detail::wire::com_query && roll(server_.options_.truncate_rate))
+			{
+				out.resize(out.size() / 2);
+
+				return respond(std::move(out), true);
+			}
+
+			respond(std::move(out));
+		}
+
+		void respond(std::string out, bool last = false)
+		{
+			auto delay = server_.options_.latency;
+
+			if (server_.options_.jitter.count() > 0)
+			{
+				delay += std::chrono::microseconds(std::uniform_int_distribution<std::int64_t>(
+					0, server_.options_.jitter.count())(random_));
+			}
+
+			if (delay.count() <= 0)
+				return write(std::move(out), last);
+
+			timer_.expires_after(delay);
+
+			timer_.async_wait(
+				[self = shared_from_this(), out = std::move(out), last](const boost::system::error_code& ec) mutable
+				{
+					if (ec)
+						return;
+
+					self->write(std::move(out), last);
+				});
+		}
+
+		void write(std::string out, bool last = false)
+		{
+			auto buffer = std::make_shared<std::string>(std::move(out));
+
+			boost::asio::async_write(socket_, boost::asio::buffer(*buffer),
+									 [self = shared_from_this(), buffer, last](const boost::system::error_code& ec,
+																			   std::size_t)
+									 {
+										 if (ec)
+											 return;
+
+										 if (last)
+											 return self->close();
+
+										 self->read();
+									 });
+		}
+
+		void close()
+		{
+			boost::system::error_code ec;
+
+			socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+
+			socket_.close(ec);
+		}
+
+		bool roll(double rate)
+		{
+			if (rate <= 0)
+				return false;
+
+			return std::uniform_real_distribution<double>(0, 1)(random_) < rate;
+		}
+
+		std::size_t begin_packet(std::string& out)
+		{
+			auto pos = out.size();
+
+			out.append(4, '\0');
+
+			return pos;
+		}
+
+		void end_packet(std::string& out, std::size_t pos)
+		{
+			auto size = out.size() - pos - 4;
+
+			out[pos] = static_cast<char>(size & 0xff);
+			out[pos + 1] = static_cast<char>((size >> 8) & 0xff);
+			out[pos + 2] = static_cast<char>((size >> 16) & 0xff);
+			out[pos + 3] = static_cast<char>(seq_++);
+		}
+
+		bool deprecate_eof() const
+		{
+			return (client_capabilities_ & detail::wire::deprecate_eof) != 0;
+		}
+
+		void write_handshake(std::string& out)
+		{
+			seq_ = 0;
+
+			auto pos = begin_packet(out);
+
+			std::string scramble{};
+
+			for (int i = 0; i < 20; ++i)
+			{
+				scramble += static_cast<char>('a' + (id_ + i) % 26);
+			}
+
+			out += static_cast<char>(10);
+			out += "8.0.36-aquarius-stand-in";
+			out += '\0';
+			detail::put_int(out, id_, 4);
+			out += scramble.substr(0, 8);
+			out += '\0';
+			detail::put_int(out, detail::wire::server_capabilities & 0xffff, 2);
+			detail::put_int(out, detail::wire::collation_utf8mb4, 1);
+			detail::put_int(out, detail::wire::status_autocommit, 2);
+			detail::put_int(out, detail::wire::server_capabilities >> 16, 2);
+			detail::put_int(out, 21, 1);
+			out.append(10, '\0');
+			out += scramble.substr(8);
+			out += '\0';
+			out += "mysql_native_password";
+			out += '\0';
+
+			end_packet(out, pos);
+		}
+
+		void write_ok(std::string& out, std::uint64_t affected_rows, std::uint64_t last_insert_id,
+					  char header = '\0')
+		{
+			auto pos = begin_packet(out);
+
+			out += header;
+			detail::put_lenenc(out, affected_rows);
+			detail::put_lenenc(out, last_insert_id);
+			detail::put_int(out, detail::wire::status_autocommit, 2);
+			detail::put_int(out, 0, 2);
+
+			end_packet(out, pos);
+		}
+
+		void write_eof(std::string& out)
+		{
+			if (deprecate_eof())
+				return write_ok(out, 0, 0, static_cast<char>(0xfe));
+
+			auto pos = begin_packet(out);
+
+			out += static_cast<char>(0xfe);
+			detail::put_int(out, 0, 2);
+			detail::put_int(out, detail::wire::status_autocommit, 2);
+
+			end_packet(out, pos);
+		}
+
+		void write_error(std::string& out, std::uint16_t code, std::string_view state, std::string_view message)
+		{
+			auto pos = begin_packet(out);
+
+			out += static_cast<char>(0xff);
+			detail::put_int(out, code, 2);
+			out += '#';
+			out += state;
+			out += message;
+
+			end_packet(out, pos);
+		}
+
+		void write_column(std::string& out, std::string_view table, const stand_in_column& column)
+		{
+			auto pos = begin_packet(out);
+
+			std::uint16_t collation = detail::wire::collation_binary;
+			std::uint32_t length = 20;
+			std::uint8_t type = detail::wire::type_longlong;
+			std::uint8_t decimals = 0;
+
+			switch (column.type)
+			{
+			case stand_in_type::integer:
+				break;
+			case stand_in_type::floating:
+				length = 22;
+				type = detail::wire::type_double;
+				decimals = 31;
+				break;
+			case stand_in_type::text:
+				collation = detail::wire::collation_utf8mb4;
+				length = 1024;
+				type = detail::wire::type_var_string;
+				break;
+			case stand_in_type::datetime:
+				length = 19;
+				type = detail::wire::type_datetime;
+				break;
+			}
+
+			detail::put_lenenc_str(out, "def");
+			detail::put_lenenc_str(out, "stand_in");
+			detail::put_lenenc_str(out, table);
+			detail::put_lenenc_str(out, table);
+			detail::put_lenenc_str(out, column.name);
+			detail::put_lenenc_str(out, column.name);
+			detail::put_lenenc(out, 0x0c);
+			detail::put_int(out, collation, 2);
+			detail::put_int(out, length, 4);
+			detail::put_int(out, type, 1);
+			detail::put_int(out, 0, 2);
+			detail::put_int(out, decimals, 1);
+			detail::put_int(out, 0, 2);
+
+			end_packet(out, pos);
+		}
+
+		void write_binary_value(std::string& out, stand_in_type type, const std::string& value)
+		{
+			switch (type)
+			{
+			case stand_in_type::integer:
+			{
+				std::int64_t number = 0;
+
+				std::from_chars(value.data(), value.data() + value.size(), number);
+
+				detail::put_int(out, static_cast<std::uint64_t>(number), 8);
+			}
+			break;
+			case stand_in_type::floating:
+			{
+				auto number = std::strtod(value.c_str(), nullptr);
+
+				std::uint64_t bits = 0;
+
+				std::memcpy(&bits, &number, sizeof(bits));
+
+				detail::put_int(out, bits, 8);
+			}
+			break;
+			case stand_in_type::text:
+				detail::put_lenenc_str(out, value);
+				break;
+			case stand_in_type::datetime:
+			{
+				int parts[7]{};
+
+				detail::parse_datetime(value, parts);
+
+				out += static_cast<char>(parts[6] != 0 ? 11 : 7);
+				detail::put_int(out, parts[0], 2);
+
+				for (int i = 1; i < 6; ++i)
+				{
+					detail::put_int(out, parts[i], 1);
+				}
+
+				if (parts[6] != 0)
+					detail::put_int(out, parts[6], 4);
+			}
+			break;
+			}
+		}
+
+		void write_result(std::string& out, const stand_in_result& result, bool binary)
+		{
+			if (result.error_code != 0)
+				return write_error(out, result.error_code, result.sql_state, result.error_message);
+
+			if (result.columns.empty())
+				return write_ok(out, result.affected_rows, result.last_insert_id);
+
+			auto pos = begin_packet(out);
+
+			detail::put_lenenc(out, result.columns.size());
+
+			end_packet(out, pos);
+
+			for (const auto& column : result.columns)
+			{
+				write_column(out, result.table, column);
+			}
+
+			if (!deprecate_eof())
+				write_eof(out);
+
+			for (const auto& row : result.rows)
+			{
+				pos = begin_packet(out);
+
+				if (binary)
+				{
+					out += '\0';
+
+					auto bitmap = out.size();
+
+					out.append((result.columns.size() + 9) / 8, '\0');
+
+					for (std::size_t i = 0; i < result.columns.size(); ++i)
+					{
+						if (i >= row.size() || !row[i])
+						{
+							out[bitmap + (i + 2) / 8] |= static_cast<char>(1 << ((i + 2) % 8));
+
+							continue;
+						}
+
+						write_binary_value(out, result.columns[i].type, *row[i]);
+					}
+				}
+				else
+				{
+					for (std::size_t i = 0; i < result.columns.size(); ++i)
+					{
+						if (i >= row.size() || !row[i])
+						{
+							out += static_cast<char>(0xfb);
+
+							continue;
+						}
+
+						detail::put_lenenc_str(out, *row[i]);
+					}
+				}
+
+				end_packet(out, pos);
+			}
+
+			write_eof(out);
+		}
+
+		void write_prepare(std::string& out, std::string_view sql)
+		{
+			auto id = ++statement_id_;
+
+			auto& statement = statements_[id];
+
+			statement.sql = sql;
+			statement.params = detail::count_placeholders(sql);
+
+			auto pos = begin_packet(out);
+
+			out += '\0';
+			detail::put_int(out, id, 4);
+			detail::put_int(out, 0, 2);
+			detail::put_int(out, statement.params, 2);
+			out += '\0';
+			detail::put_int(out, 0, 2);
+
+			end_packet(out, pos);
+
+			if (statement.params == 0)
+				return;
+
+			for (std::size_t i = 0; i < statement.params; ++i)
+			{
+				write_column(out, {}, { "?", stand_in_type::text });
+			}
+
+			if (!deprecate_eof())
+				write_eof(out);
+		}
+
+		void write_execute(std::string& out, std::string_view body)
+		{
+			detail::wire_reader reader(body);
+
+			auto iter = statements_.find(static_cast<std::uint32_t>(reader.get_int(4)));
+
+			if (iter == statements_.end())
+				return write_error(out, 1243, "HY000", "Unknown prepared statement handler");
+
+			auto& statement = iter->second;
+
+			reader.get_int(5);
+
+			std::vector<std::string> values{};
+
+			if (statement.params != 0)
+			{
+				auto bitmap = reader.get_bytes((statement.params + 7) / 8);
+
+				if (reader.get_int(1) == 1)
+				{
+					statement.types.clear();
+
+					for (std::size_t i = 0; i < statement.params; ++i)
+					{
+						statement.types.push_back(static_cast<std::uint8_t>(reader.get_int(1)));
+
+						reader.get_int(1);
+					}
+				}
+
+				for (std::size_t i = 0; i < statement.params; ++i)
+				{
+					if (static_cast<std::uint8_t>(bitmap[i / 8]) & (1 << (i % 8)))
+					{
+						values.emplace_back(NULL_VALUE);
+
+						continue;
+					}
+
+					values.push_back(read_param(reader, i < statement.types.size() ? statement.types[i]
+																					 : detail::wire::type_null));
+				}
+			}
+
+			write_result(out, *server_.handle(inline_params(statement.sql, values)), true);
+		}
+
+		static std::string read_param(detail::wire_reader& reader, std::uint8_t type)
+		{
+			std::string result{};
+
+			switch (type)
+			{
+			case detail::wire::type_tiny:
+				return std::to_string(static_cast<std::int8_t>(reader.get_int(1)));
+			case detail::wire::type_short:
+			case detail::wire::type_year:
+				return std::to_string(static_cast<std::int16_t>(reader.get_int(2)));
+			case detail::wire::type_long:
+			case detail::wire::type_int24:
+				return std::to_string(static_cast<std::int32_t>(reader.get_int(4)));
+			case detail::wire::type_longlong:
+				return std::to_string(static_cast<std::int64_t>(reader.get_int(8)));
+			case detail::wire::type_float:
+			{
+				auto bits = static_cast<std::uint32_t>(reader.get_int(4));
+
+				float value{};
+
+				std::memcpy(&value, &bits, sizeof(value));
+
+				append_sql_value(result, value);
+
+				return result;
+			}
+			case detail::wire::type_double:
+			{
+				auto bits = reader.get_int(8);
+
+				double value{};
+
+				std::memcpy(&value, &bits, sizeof(value));
+
+				append_sql_value(result, value);
+
+				return result;
+			}
+			case detail::wire::type_date:
+			case detail::wire::type_datetime:
+			case detail::wire::type_timestamp:
+			{
+				auto size = reader.get_int(1);
+
+				int parts[7]{};
+
+				if (size >= 4)
+				{
+					parts[0] = static_cast<int>(reader.get_int(2));
+					parts[1] = static_cast<int>(reader.get_int(1));
+					parts[2] = static_cast<int>(reader.get_int(1));
+				}
+
+				if (size >= 7)
+				{
+					parts[3] = static_cast<int>(reader.get_int(1));
+					parts[4] = static_cast<int>(reader.get_int(1));
+					parts[5] = static_cast<int>(reader.get_int(1));
+				}
+
+				if (size >= 11)
+					parts[6] = static_cast<int>(reader.get_int(4));
+
+				char buffer[40]{};
+
+				std::snprintf(buffer, sizeof(buffer), "'%04d-%02d-%02d %02d:%02d:%02d.%06d'", parts[0], parts[1],
+							  parts[2], parts[3], parts[4], parts[5], parts[6]);
+
+				return buffer;
+			}
+			case detail::wire::type_time:
+			{
+				reader.get_bytes(static_cast<std::size_t>(reader.get_int(1)));
+
+				return "'00:00:00'";
+			}
+			case detail::wire::type_null:
+				return std::string(NULL_VALUE);
+			default:
+				append_sql_value(result, reader.get_lenenc_str());
+
+				return result;
+			}
+		}
+
+	private:
+		stand_in_server& server_;
+
+		boost::asio::ip::tcp::socket socket_;
+
+		boost::asio::steady_timer timer_;
+
+		std::uint32_t id_;
+
+		std::mt19937 random_;
+
+		std::array<unsigned char, 4> header_{};
+
+		std::string payload_;
+
+		std::uint8_t seq_ = 0;
+
+		bool authenticated_ = false;
+
+		std::uint32_t client_capabilities_ = 0;
+
+		std::uint32_t statement_id_ = 0;
+
+		std::unordered_map<std::uint32_t, prepared> statements_;
+	};
+
+	inline void stand_in_server::accept()
+	{
+		acceptor_.async_accept(
+			[this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket)
+			{
+				if (ec)
+					return;
+
+				auto id = static_cast<std::uint32_t>(connections_.fetch_add(1, std::memory_order_relaxed) + 1);
+
+				std::make_shared<session>(*this, std::move(socket), id)->start();
+
+				accept();
+			});
+	}
+} // namespace aquarius
@@ -1,7 +1,10 @@
 #pragma once
+#include "mysql_server.h"
 #include <aquarius/mysql.hpp>
 #include <boost/test/unit_test_suite.hpp>
 #include <chrono>
+#include <future>
+#include <optional>
 
 using namespace std::chrono_literals;
 
@@ -17,6 +20,43 @@ struct products
 	int vend_id;
 };
 
+struct vendors
+{
+	int vend_id;
+	std::string vend_name;
+};
+
+struct reflect_products
+{
+	REFLECT_DEFINE(int prod_id; std::string prod_name; int prod_price; int vend_id;)
+};
+
+struct reflect_vendors
+{
+	REFLECT_DEFINE(int vend_id; std::string vend_name;)
+};
+
+struct test_flags
+{
+	unsigned a : 1, b : 1, c : 1, d : 1, e : 1, f : 1, g : 1, h : 1, i : 1, j : 1, k : 1, l : 1;
+};
+
+struct test_column
+{
+	std::string_view table_name;
+	std::string_view name;
+
+	std::string_view table() const
+	{
+		return table_name;
+	}
+
+	std::string_view column_name() const
+	{
+		return name;
+	}
+};
+
 BOOST_AUTO_TEST_CASE(connect)
 {
 	aquarius::io_service_pool io_pool{ 5 };
@@ -30,6 +70,18 @@ BOOST_AUTO_TEST_CASE(connect)
 
 	BOOST_CHECK_EQUAL(aquarius::insert(pool, products{ 1, "pro", 2, 3 }), true);
 
+	BOOST_CHECK(aquarius::chain_sql(pool).prepare_insert(products{ 2, "o'neil", 4, 3 }).execute());
+	BOOST_CHECK(aquarius::chain_sql(pool).prepare_replace(products{ 2, "o'neil", 5, 3 }).execute());
+
+	std::promise<bool> replaced{};
+
+	aquarius::chain_sql(pool)
+		.prepare_replace(products{ 2, "o'neil", 6, 3 })
+		.async_execute([&](bool value) { replaced.set_value(value); });
+
+	BOOST_CHECK(replaced.get_future().get());
+	BOOST_CHECK(aquarius::remove_if<products>(pool, AQUARIUS_EXPR(prod_id) == 2));
+
 	auto select_result = aquarius::select_if<products>(pool, AQUARIUS_EXPR(prod_id) == 1);
 
 	if (!select_result.empty())
@@ -41,6 +93,15 @@ BOOST_AUTO_TEST_CASE(connect)
 		BOOST_CHECK_EQUAL(last_one.prod_price, 2);
 		BOOST_CHECK_EQUAL(last_one.vend_id, 3);
 
+		auto prepared = aquarius::select_chain(pool)
+							.select<products>()
+							.prepare_where(AQUARIUS_EXPR(prod_id) == 1 & AQUARIUS_EXPR(prod_name) == "pro")
+							.limit<1>()
+							.query<products>();
+
+		BOOST_CHECK_EQUAL(prepared.size(), 1);
+		BOOST_CHECK(aquarius::select_chain(pool).exists<products>().prepare_where(AQUARIUS_EXPR(prod_id) == 1).any());
+
 		BOOST_CHECK_EQUAL(aquarius::remove_if<products>(pool, AQUARIUS_EXPR(prod_id) == 1), true);
 
 		std::this_thread::sleep_for(3s);
@@ -146,6 +207,42 @@ BOOST_AUTO_TEST_CASE(sql)
 
 		BOOST_CHECK_EQUAL(
 			sql, "select prod_name, prod_price from products where prod_name != '3.49' or prod_name <= '3.91'");
+
+		BOOST_CHECK_EQUAL(mysql_sql(pool).count<products>().sql(), "select count(*) from products");
+
+		sql = mysql_sql(pool).count<products>().where(AQUARIUS_EXPR(vend_id) == 3).sql();
+		BOOST_CHECK_EQUAL(sql, "select count(*) from products where vend_id = 3");
+
+		sql = mysql_sql(pool).max<products, "prod_price">().sql();
+		BOOST_CHECK_EQUAL(sql, "select max(prod_price) from products");
+
+		sql = mysql_sql(pool).exists<products>().where(AQUARIUS_EXPR(prod_id) == 1).sql();
+		BOOST_CHECK_EQUAL(sql, "select 1 from products where prod_id = 1");
+
+		sql = mysql_sql(pool)
+				  .left_join<products, vendors>(AQUARIUS_EXPR(products.vend_id) == AQUARIUS_EXPR(vendors.vend_id))
+				  .sql();
+		BOOST_CHECK_EQUAL(sql, "select products.*, vendors.* from products left join vendors on products.vend_id = "
+							   "vendors.vend_id");
+
+		sql = mysql_sql(pool)
+				  .join<reflect_products, reflect_vendors>(AQUARIUS_EXPR(reflect_products.vend_id) ==
+														   AQUARIUS_EXPR(reflect_vendors.vend_id))
+				  .sql();
+		BOOST_CHECK_EQUAL(sql, "select reflect_products.prod_id, reflect_products.prod_name, reflect_products.prod_price, "
+							   "reflect_products.vend_id, reflect_vendors.vend_id, reflect_vendors.vend_name from "
+							   "reflect_products join reflect_vendors on reflect_products.vend_id = "
+							   "reflect_vendors.vend_id");
+
+		sql = mysql_sql(pool)
+				  .select<products>()
+				  .max_execution_time<1000>()
+				  .straight_join()
+				  .force_index<"idx_vend">()
+				  .where(AQUARIUS_EXPR(vend_id) == 3)
+				  .sql();
+		BOOST_CHECK_EQUAL(sql, "select /*+ max_execution_time(1000) */ straight_join * from products force index "
+							   "(idx_vend) where vend_id = 3");
 	}
 
 	{
@@ -176,4 +273,1083 @@ BOOST_AUTO_TEST_CASE(sql)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(reflection)
+{
+	static_assert(sizeof(test_flags) < 12);
+	static_assert(aquarius::tuple_size_v<test_flags> == 12);
+
+	products value{ 1, "ridy", 6, 7 };
+
+	auto fields = aquarius::tie_fields(value);
+
+	aquarius::get<2>(fields) = 8;
+
+	BOOST_CHECK_EQUAL(value.prod_price, 8);
+	BOOST_CHECK_EQUAL(aquarius::get<1>(fields), "ridy");
+	BOOST_CHECK_EQUAL(aquarius::get<3>(value), 7);
+}
+
+BOOST_AUTO_TEST_CASE(projection)
+{
+	BOOST_CHECK_EQUAL((aquarius::field_index<reflect_products, "prod_id">()), 0);
+	BOOST_CHECK_EQUAL((aquarius::field_index<reflect_products, "prod_name">()), 1);
+	BOOST_CHECK_EQUAL((aquarius::field_index<reflect_products, "vend_id">()), 3);
+
+	BOOST_CHECK_EQUAL((aquarius::field_index<products, "prod_price">()), 2);
+	BOOST_CHECK_EQUAL(aquarius::field_names<vendors>()[1], "vend_name");
+
+	std::vector<boost::mysql::field_view> row{ boost::mysql::field_view("ridy"), boost::mysql::field_view(7) };
+
+	auto plain = aquarius::to_struct<products, "prod_name", "vend_id">(row);
+
+	BOOST_CHECK_EQUAL(plain.prod_id, 0);
+	BOOST_CHECK_EQUAL(plain.prod_name, "ridy");
+	BOOST_CHECK_EQUAL(plain.prod_price, 0);
+	BOOST_CHECK_EQUAL(plain.vend_id, 7);
+
+	row = { boost::mysql::field_view(3), boost::mysql::field_view(9) };
+
+	auto reflected = aquarius::to_struct<reflect_products, "vend_id", "prod_id">(row);
+
+	BOOST_CHECK_EQUAL(reflected.prod_id, 9);
+	BOOST_CHECK(reflected.prod_name.empty());
+	BOOST_CHECK_EQUAL(reflected.vend_id, 3);
+
+	using view_type = aquarius::result_view<reflect_products>;
+
+	static_assert(std::forward_iterator<view_type::const_iterator>);
+
+	view_type view{};
+
+	BOOST_CHECK(view.empty());
+	BOOST_CHECK(view.begin() == view.end());
+	BOOST_CHECK(std::distance(view.begin(), view.end()) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(pmr_result)
+{
+	aquarius::pmr_result<products> result(2);
+
+	result.emplace_back(products{ 1, "ridy", 6, 7 });
+
+	auto moved = std::move(result);
+
+	BOOST_CHECK_EQUAL(moved.size(), 1);
+	BOOST_CHECK_EQUAL(moved[0].prod_name, "ridy");
+	BOOST_CHECK_EQUAL(result.size(), 0);
+	BOOST_CHECK(result.empty());
+	BOOST_CHECK(result.begin() == result.end());
+
+	result.emplace_back(products{ 2, "candy", 3, 1 });
+
+	BOOST_CHECK_EQUAL(result.size(), 1);
+	BOOST_CHECK_EQUAL(result[0].prod_id, 2);
+}
+
+BOOST_AUTO_TEST_CASE(interned_string)
+{
+	using dictionary = aquarius::string_dictionary<products>;
+
+	using region = aquarius::interned_string<products>;
+
+	auto first = region::from_field(boost::mysql::field_view("north"));
+	auto second = region::from_field(boost::mysql::field_view("north"));
+
+	BOOST_CHECK(first == second);
+	BOOST_CHECK(first.shares(second));
+	BOOST_CHECK_EQUAL(first.view(), "north");
+	BOOST_CHECK(region::from_field(boost::mysql::field_view(1)).empty());
+
+	dictionary values(2);
+
+	region held("east", values);
+
+	region("west", values);
+
+	BOOST_CHECK_EQUAL(values.size(), 2);
+
+	region south("south", values);
+
+	BOOST_CHECK_EQUAL(values.size(), 2);
+	BOOST_CHECK_EQUAL(south.view(), "south");
+	BOOST_CHECK(!south.shares(region("south", values)));
+
+	region("north", values);
+
+	BOOST_CHECK_EQUAL(values.size(), 2);
+	BOOST_CHECK(held.shares(region("east", values)));
+	BOOST_CHECK(region("north", values).shares(region("north", values)));
+	BOOST_CHECK(region("north", values) == first);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_string)
+{
+	aquarius::fixed_string<4> ascii("abcdef");
+
+	BOOST_CHECK_EQUAL(ascii.view(), "abcd");
+	BOOST_CHECK(ascii.truncated());
+
+	aquarius::fixed_string<4> fits("abcd");
+
+	BOOST_CHECK_EQUAL(fits.view(), "abcd");
+	BOOST_CHECK(!fits.truncated());
+
+	aquarius::fixed_string<3> wide("\xe4\xbd\xa0\xe5\xa5\xbd\xf0\x9f\x98\x80");
+
+	BOOST_CHECK_EQUAL(wide.size(), 10);
+	BOOST_CHECK(!wide.truncated());
+
+	aquarius::fixed_string<2> cut("\xe4\xbd\xa0\xe5\xa5\xbd\xf0\x9f\x98\x80");
+
+	BOOST_CHECK_EQUAL(cut.view(), "\xe4\xbd\xa0\xe5\xa5\xbd");
+	BOOST_CHECK(cut.truncated());
+
+	std::string_view column = "a\xf0\x9f\x98\x80"
+							 "b";
+
+	auto decoded = aquarius::fixed_string<2>::from_field(boost::mysql::field_view(column));
+
+	BOOST_CHECK_EQUAL(decoded.view(), "a\xf0\x9f\x98\x80");
+	BOOST_CHECK(decoded.truncated());
+}
+
+BOOST_AUTO_TEST_CASE(field_types)
+{
+	using price = aquarius::decimal<6, 2>;
+
+	BOOST_CHECK_EQUAL(price::parse("1234.5")->unscaled(), 123450);
+	BOOST_CHECK_EQUAL(price::parse("-0.07")->unscaled(), -7);
+	BOOST_CHECK_EQUAL(price::parse(".5")->unscaled(), 50);
+	BOOST_CHECK_EQUAL(price::parse("0001.005")->unscaled(), 101);
+	BOOST_CHECK_EQUAL(price::parse("-1.994")->unscaled(), -199);
+	BOOST_CHECK(!price::parse("").has_value());
+	BOOST_CHECK(!price::parse("-").has_value());
+	BOOST_CHECK(!price::parse("1.2.3").has_value());
+	BOOST_CHECK(!price::parse("12a").has_value());
+	BOOST_CHECK(!price::parse("12345.6").has_value());
+	BOOST_CHECK(!price::parse("9999.995").has_value());
+
+	BOOST_CHECK_EQUAL(price::from_unscaled(123405).to_string(), "1234.05");
+	BOOST_CHECK_EQUAL(price::from_unscaled(-5).to_string(), "-0.05");
+	BOOST_CHECK_EQUAL((aquarius::decimal<4, 0>(12).to_string()), "12");
+
+	BOOST_CHECK_EQUAL(price::from_field(boost::mysql::field_view(0.29)).unscaled(), 29);
+	BOOST_CHECK_EQUAL(price::from_field(boost::mysql::field_view(-1.15)).unscaled(), -115);
+	BOOST_CHECK_EQUAL(price::from_field(boost::mysql::field_view("19.99")).unscaled(), 1999);
+
+	using namespace std::chrono;
+
+	std::string sql{};
+
+	aquarius::append_datetime(sql, sys_days{ 2024y / 2 / 29 } + 13h + 5min + 9s + 42us);
+	BOOST_CHECK_EQUAL(sql, "2024-02-29 13:05:09.000042");
+
+	sql.clear();
+
+	aquarius::append_datetime(sql, sys_days{ 1969y / 12 / 31 } + 23h + 59min + 59s + 999999us);
+	BOOST_CHECK_EQUAL(sql, "1969-12-31 23:59:59.999999");
+
+	std::vector<boost::mysql::field_view> params{};
+
+	std::deque<std::string> storage{};
+
+	{
+		products temp{ 1, "temporary", 2, 3 };
+
+		aquarius::for_each(temp, [&](auto&& value) { params.push_back(aquarius::to_field(value, storage)); });
+
+		temp.prod_name.assign(64, 'x');
+	}
+
+	BOOST_CHECK_EQUAL(params.size(), 4);
+	BOOST_CHECK_EQUAL(params[1].as_string(), "temporary");
+}
+
+BOOST_AUTO_TEST_CASE(aggregate_decode)
+{
+	static_assert(std::same_as<aquarius::sum_value_t<reflect_products, "prod_price">, std::int64_t>);
+	static_assert(std::same_as<aquarius::sum_value_t<products, "prod_price">, double>);
+	static_assert(std::same_as<aquarius::aggregate_value_t<reflect_products, "prod_price">, int>);
+	static_assert(std::same_as<aquarius::aggregate_value_t<reflect_products, "prod_name">, std::string>);
+
+	using sum_type = aquarius::sum_value_t<reflect_products, "prod_price">;
+
+	BOOST_CHECK_EQUAL(aquarius::cast<sum_type>(boost::mysql::field_view("6000000000")), 6000000000LL);
+	BOOST_CHECK_EQUAL(aquarius::cast<sum_type>(boost::mysql::field_view(std::int64_t(-6000000000))), -6000000000LL);
+	BOOST_CHECK_EQUAL((aquarius::cast<aquarius::aggregate_value_t<reflect_products, "prod_price">>(
+						  boost::mysql::field_view(42))),
+					  42);
+}
+
+BOOST_AUTO_TEST_CASE(column_map)
+{
+	std::vector<test_column> meta{ { "products", "VEND_ID" }, { "products", "extra" }, { "products", "Prod_Name" },
+								   { "products", "prod_id" } };
+
+	auto index = aquarius::column_map<reflect_products>::get(meta);
+
+	BOOST_CHECK_EQUAL(index[0], 3);
+	BOOST_CHECK_EQUAL(index[1], 2);
+	BOOST_CHECK_EQUAL(index[2], aquarius::npos_column);
+	BOOST_CHECK_EQUAL(index[3], 0);
+
+	std::vector<boost::mysql::field_view> row{ boost::mysql::field_view(7), boost::mysql::field_view("x"),
+											   boost::mysql::field_view("ridy"), boost::mysql::field_view(1) };
+
+	auto value = aquarius::to_struct<reflect_products>(row, index);
+
+	BOOST_CHECK_EQUAL(value.prod_id, 1);
+	BOOST_CHECK_EQUAL(value.prod_name, "ridy");
+	BOOST_CHECK_EQUAL(value.prod_price, 0);
+	BOOST_CHECK_EQUAL(value.vend_id, 7);
+
+	BOOST_CHECK(aquarius::column_map<reflect_products>::get(meta) == index);
+
+	static_assert(aquarius::named_fields_t<products>);
+	static_assert(!aquarius::named_fields_t<std::tuple<int, std::string>>);
+
+	auto plain = aquarius::column_map<products>::get(meta);
+
+	BOOST_CHECK(plain == index);
+
+	auto plain_value = aquarius::to_struct<products>(row, plain);
+
+	BOOST_CHECK_EQUAL(plain_value.prod_id, 1);
+	BOOST_CHECK_EQUAL(plain_value.prod_name, "ridy");
+	BOOST_CHECK_EQUAL(plain_value.vend_id, 7);
+}
+
+BOOST_AUTO_TEST_CASE(join_decode)
+{
+	using joined = std::tuple<reflect_products, std::optional<reflect_vendors>>;
+
+	std::vector<test_column> meta{ { "reflect_products", "prod_id" },	 { "reflect_products", "created" },
+								   { "reflect_products", "PROD_PRICE" }, { "reflect_products", "prod_name" },
+								   { "reflect_products", "vend_id" },	 { "reflect_vendors", "vend_name" },
+								   { "reflect_vendors", "vend_id" } };
+
+	auto index = aquarius::make_join_index<joined>(meta);
+
+	std::vector<boost::mysql::field_view> row{ boost::mysql::field_view(1),		  boost::mysql::field_view("2024-01-01"),
+											   boost::mysql::field_view(5),		  boost::mysql::field_view("pen"),
+											   boost::mysql::field_view(7),		  boost::mysql::field_view("acme"),
+											   boost::mysql::field_view(7) };
+
+	auto [product, vendor] = aquarius::to_join<joined>(row, index);
+
+	BOOST_CHECK_EQUAL(product.prod_id, 1);
+	BOOST_CHECK_EQUAL(product.prod_name, "pen");
+	BOOST_CHECK_EQUAL(product.prod_price, 5);
+	BOOST_CHECK_EQUAL(product.vend_id, 7);
+	BOOST_CHECK(vendor.has_value());
+	BOOST_CHECK_EQUAL(vendor->vend_id, 7);
+	BOOST_CHECK_EQUAL(vendor->vend_name, "acme");
+
+	row[5] = boost::mysql::field_view();
+	row[6] = boost::mysql::field_view();
+
+	BOOST_CHECK(!std::get<1>(aquarius::to_join<joined>(row, index)).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(scan_split)
+{
+	using limits = std::numeric_limits<int64_t>;
+
+	using key_range = std::pair<int64_t, int64_t>;
+
+	auto ranges = aquarius::split_range({ 1, 10, 10 }, 3);
+
+	BOOST_CHECK_EQUAL(ranges.size(), 3);
+	BOOST_CHECK(ranges[0] == key_range(1, 4));
+	BOOST_CHECK(ranges[1] == key_range(5, 8));
+	BOOST_CHECK(ranges[2] == key_range(9, 10));
+
+	ranges = aquarius::split_range({ 5, 6, 2 }, 6);
+
+	BOOST_CHECK_EQUAL(ranges.size(), 2);
+	BOOST_CHECK(ranges[1] == key_range(6, 6));
+
+	BOOST_CHECK(aquarius::split_range({ 1, 10, 0 }, 6).empty());
+
+	ranges = aquarius::split_range({ limits::min(), limits::max(), 3 }, 4);
+
+	BOOST_CHECK_EQUAL(ranges.size(), 4);
+	BOOST_CHECK_EQUAL(ranges.front().first, limits::min());
+	BOOST_CHECK_EQUAL(ranges.back().second, limits::max());
+
+	for (std::size_t i = 1; i < ranges.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(ranges[i].first, ranges[i - 1].second + 1);
+	}
+
+	ranges = aquarius::split_range({ limits::min(), limits::max(), 3 }, 1);
+
+	BOOST_CHECK_EQUAL(ranges.size(), 1);
+	BOOST_CHECK(ranges[0] == std::make_pair(limits::min(), limits::max()));
+}
+
+BOOST_AUTO_TEST_CASE(expression)
+{
+	BOOST_CHECK_EQUAL((AQUARIUS_EXPR(prod_id).in(1, 2, 3) & AQUARIUS_EXPR(prod_name).like("c%")).sql(),
+					  " prod_id in (1,2,3) and prod_name like 'c%'");
+
+	BOOST_CHECK_EQUAL(((AQUARIUS_EXPR(prod_id) == 1 | AQUARIUS_EXPR(vend_id) > 2) & AQUARIUS_EXPR(prod_price).is_null())
+						  .sql(),
+					  " (prod_id = 1 or vend_id > 2) and prod_price is null");
+
+	BOOST_CHECK_EQUAL((!AQUARIUS_EXPR(prod_price).between(1, 5)).sql(), " not (prod_price between 1 and 5)");
+
+	BOOST_CHECK_EQUAL((AQUARIUS_EXPR(prod_name) == "o'neil").sql(), " prod_name = 'o''neil'");
+
+	std::string sql{};
+	std::vector<boost::mysql::field_view> params{};
+	std::deque<std::string> storage{};
+
+	(AQUARIUS_EXPR(prod_id).in(std::vector<int>{ 1, 2 }) | AQUARIUS_EXPR(prod_name) == "candy")
+		.prepare(sql, params, storage);
+
+	BOOST_CHECK_EQUAL(sql, " prod_id in (?,?) or prod_name = ?");
+	BOOST_CHECK_EQUAL(params.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(metrics)
+{
+	aquarius::latency_histogram histogram{};
+
+	for (std::uint64_t i = 1; i <= 1000; ++i)
+	{
+		histogram.record(i * 1000);
+	}
+
+	auto snapshot = histogram.snapshot();
+
+	BOOST_CHECK_EQUAL(snapshot.count, 1000);
+	BOOST_CHECK_EQUAL(snapshot.max, 1000000);
+	BOOST_CHECK(snapshot.p50 >= 500000 && snapshot.p50 <= 500000 + 500000 / 16);
+
+	aquarius::pool_metrics metrics{};
+
+	metrics.acquired(100);
+	metrics.executed(5000, boost::mysql::error_code(1062, boost::system::generic_category()));
+	metrics.executed(5000, boost::mysql::error_code(1062, boost::system::system_category()));
+
+	auto text = aquarius::to_prometheus(metrics.snapshot(0));
+
+	BOOST_CHECK(text.find("aquarius_mysql_errors_by_code_total{category=\"generic\",code=\"1062\"} 1") !=
+				std::string::npos);
+	BOOST_CHECK(text.find("aquarius_mysql_errors_by_code_total{category=\"system\",code=\"1062\"} 1") !=
+				std::string::npos);
+	BOOST_CHECK(text.find("aquarius_mysql_execute_latency_seconds_count 2") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(digest)
+{
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from products where prod_id = 42 and name = 'it''s'"),
+					  "select * from products where prod_id = ? and name = ?");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from t1 where id in (1, 2,3)  ;"),
+					  "select * from t1 where id in (...)");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("insert into t1 values(1,'a',0x1F)"), "insert into t1 values(...)");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from t1 where id in (1)"),
+					  aquarius::fingerprint("select * from t1 where id in (1, 2)"));
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from t1 where id in ('a')"),
+					  "select * from t1 where id in (...)");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from t1 where id = -5"), "select * from t1 where id = ?");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select * from t1 where id in (-1, -2)"),
+					  "select * from t1 where id in (...)");
+	BOOST_CHECK_EQUAL(aquarius::fingerprint("select a-1, a - 1 from t1"), "select a-?, a - ? from t1");
+
+	aquarius::digest_table table{};
+
+	table.record("select * from t1 where id = 1", 1000, false, 1, 16);
+	table.record("select * from t1 where id = 2", 3000, true, 0, 0);
+	table.record("delete from t1", 100, false, 0, 0);
+
+	auto snapshot = table.snapshot();
+
+	BOOST_CHECK_EQUAL(snapshot.size(), 2);
+	BOOST_CHECK_EQUAL(snapshot[0].text, "select * from t1 where id = ?");
+	BOOST_CHECK_EQUAL(snapshot[0].calls, 2);
+	BOOST_CHECK_EQUAL(snapshot[0].errors, 1);
+	BOOST_CHECK_EQUAL(snapshot[0].rows, 1);
+	BOOST_CHECK_EQUAL(snapshot[0].bytes, 16);
+	BOOST_CHECK_EQUAL(snapshot[0].max, 3000);
+
+	table.reset();
+
+	BOOST_CHECK(table.snapshot().empty());
+}
+
+struct explain_service
+{
+	template <typename _Endpoint, typename _Param>
+	explain_service(boost::asio::io_service&, _Endpoint&&, _Param&&)
+	{}
+
+	template <typename _Func>
+	bool query_rows(const std::string& sql, _Func&&, boost::mysql::error_code&)
+	{
+		if (sql.starts_with("explain"))
+			explainer = std::this_thread::get_id();
+
+		return true;
+	}
+
+	void close()
+	{}
+
+	static inline std::thread::id explainer{};
+};
+
+BOOST_AUTO_TEST_CASE(slow_log)
+{
+	BOOST_CHECK_EQUAL(aquarius::inline_params("select * from t1 where a = ? and b = '?' and c = ?", { "1", "'x'" }),
+					  "select * from t1 where a = 1 and b = '?' and c = 'x'");
+
+	aquarius::slow_query_record record{};
+
+	record.latency_ns = 2500000;
+	record.connection_id = 7;
+	record.sql = "select \"a\" from t1";
+	record.params = { "1" };
+
+	BOOST_CHECK_EQUAL(aquarius::to_json(record),
+					  "{\"time_ms\":0,\"latency_ms\":2.5,\"connection_id\":7,\"digest\":\"0000000000000000\","
+					  "\"sql\":\"select \\\"a\\\" from t1\",\"params\":[\"1\"],\"plan\":null}\n");
+
+	auto path = std::filesystem::temp_directory_path() / "aquarius_slow_query.log";
+
+	std::filesystem::remove(path);
+	std::filesystem::remove(path.string() + ".1");
+
+	aquarius::slow_query_options options{};
+
+	options.path = path.string();
+	options.max_bytes = 256;
+	options.max_files = 1;
+
+	aquarius::slow_query_log log(options);
+
+	BOOST_CHECK(log.explain_due(1));
+	BOOST_CHECK(!log.explain_due(1));
+
+	for (int i = 0; i < 4; ++i)
+	{
+		log.write(record);
+	}
+
+	BOOST_CHECK(std::filesystem::exists(path.string() + ".1"));
+	BOOST_CHECK(std::filesystem::file_size(path) <= 256);
+
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<explain_service> pool(io_pool, "127.0.0.1", boost::mysql::default_port_string, "kcwl",
+												 "123456", "test_mysql");
+
+	options.threshold = std::chrono::milliseconds(0);
+	options.max_bytes = 64 * 1024;
+
+	BOOST_CHECK(pool.enable_slow_log(options));
+
+	BOOST_CHECK(pool.query_rows("select * from t1", [](const auto&, const auto&) {}));
+
+	BOOST_CHECK(!pool.enable_slow_log(options));
+	BOOST_CHECK(!pool.enable_concurrency_limit());
+
+	pool.stop();
+
+	BOOST_CHECK(explain_service::explainer != std::thread::id{});
+	BOOST_CHECK(explain_service::explainer != std::this_thread::get_id());
+}
+
+struct replay_pool
+{
+	template <typename _Func>
+	bool query_rows(const std::string& sql, _Func&&)
+	{
+		std::lock_guard lk(mutex);
+
+		issued.push_back(sql);
+
+		return !sql.starts_with("update");
+	}
+
+	std::mutex mutex;
+
+	std::vector<std::string> issued;
+};
+
+struct capture_service
+{
+	template <typename _Endpoint, typename _Param>
+	capture_service(boost::asio::io_service&, _Endpoint&&, _Param&&)
+	{}
+
+	bool execute(const std::string&, const std::vector<boost::mysql::field_view>&, boost::mysql::error_code&)
+	{
+		return true;
+	}
+
+	std::uint64_t connection_id() const
+	{
+		return 42;
+	}
+
+	template <typename _Func>
+	void async_excute(std::string_view, _Func&& f)
+	{
+		f(false, boost::mysql::error_code(boost::asio::error::connection_reset));
+	}
+
+	void close()
+	{}
+};
+
+BOOST_AUTO_TEST_CASE(capture_replay)
+{
+	auto path = std::filesystem::temp_directory_path() / "aquarius_workload.capture";
+
+	{
+		aquarius::capture_options options{};
+
+		options.path = path.string();
+
+		aquarius::capture_writer writer(options);
+
+		BOOST_CHECK(static_cast<bool>(writer));
+
+		writer.write({ 1000000, 1, 500, 3, false, "select * from t1 where id = 1" });
+		writer.write({ 900000, 2, 700, 0, true, "update t1 set a = 2 where id = 5" });
+		writer.write({ 3000000, 1, 400, 1, false, "select * from t1 where id = 2" });
+	}
+
+	aquarius::capture_reader reader(path);
+
+	aquarius::capture_record record{};
+
+	BOOST_CHECK(reader.next(record));
+	BOOST_CHECK_EQUAL(record.time_ns, 1000000);
+	BOOST_CHECK_EQUAL(record.rows, 3);
+	BOOST_CHECK(reader.next(record));
+	BOOST_CHECK_EQUAL(record.time_ns, 900000);
+	BOOST_CHECK_EQUAL(record.connection_id, 2);
+	BOOST_CHECK_EQUAL(record.latency_ns, 700);
+	BOOST_CHECK(record.failed);
+	BOOST_CHECK_EQUAL(record.sql, "update t1 set a = 2 where id = 5");
+	BOOST_CHECK(reader.next(record));
+	BOOST_CHECK(!reader.next(record));
+
+	replay_pool pool{};
+
+	aquarius::replay_options options{};
+
+	options.mode = aquarius::replay_mode::fast;
+
+	auto report = aquarius::replay(pool, path, options);
+
+	BOOST_CHECK_EQUAL(report.statements, 3);
+	BOOST_CHECK_EQUAL(report.sessions, 2);
+	BOOST_CHECK_EQUAL(report.errors, 1);
+	BOOST_CHECK_EQUAL(report.captured_ns, 2100000);
+	BOOST_CHECK_EQUAL(report.digests.size(), 2);
+	BOOST_CHECK_EQUAL(report.replayed.count, 3);
+	BOOST_CHECK_EQUAL(pool.issued.size(), 3);
+
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<capture_service> service(io_pool, "127.0.0.1", boost::mysql::default_port_string, "kcwl",
+													"123456", "test_mysql");
+
+	aquarius::capture_options capture{};
+
+	capture.path = path.string();
+
+	BOOST_CHECK(service.enable_capture(capture));
+
+	BOOST_CHECK(service.execute("update t1 set name = ? where id = ?",
+								{ boost::mysql::field_view("o'neil"), boost::mysql::field_view(5) }));
+
+	service.flush_capture();
+
+	aquarius::capture_reader prepared(path);
+
+	BOOST_CHECK(prepared.next(record));
+	BOOST_CHECK_EQUAL(record.connection_id, 42);
+	BOOST_CHECK_EQUAL(record.sql, "update t1 set name = 'o''neil' where id = 5");
+}
+
+BOOST_AUTO_TEST_CASE(pool_errors)
+{
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<capture_service> pool(io_pool, "127.0.0.1", boost::mysql::default_port_string, "kcwl",
+												 "123456", "test_mysql");
+
+	boost::mysql::error_code error{};
+
+	pool.async_execute("update t1 set a = 1",
+					   [&](bool value, const boost::mysql::error_code& ec)
+					   {
+						   BOOST_CHECK(!value);
+
+						   error = ec;
+					   });
+
+	BOOST_CHECK(error == boost::asio::error::connection_reset);
+
+	auto snapshot = pool.snapshot();
+
+	BOOST_CHECK_EQUAL(snapshot.errors, 1);
+	BOOST_CHECK_EQUAL(snapshot.live, pool.capacity());
+
+	pool.stop();
+
+	BOOST_CHECK_EQUAL(pool.snapshot().live, 0);
+}
+
+BOOST_AUTO_TEST_CASE(priority)
+{
+	using aquarius::priority_class;
+
+	BOOST_CHECK(aquarius::scoped_priority::current() == priority_class::normal);
+
+	{
+		aquarius::scoped_priority bulk(priority_class::bulk);
+
+		BOOST_CHECK(aquarius::scoped_priority::current() == priority_class::bulk);
+	}
+
+	BOOST_CHECK(aquarius::scoped_priority::current() == priority_class::normal);
+
+	aquarius::priority_gate gate{};
+
+	BOOST_CHECK(!gate.enter(priority_class::interactive));
+
+	bool entered = true;
+
+	gate.async_enter(priority_class::interactive, [&](bool value) { entered = value; });
+
+	BOOST_CHECK(!entered);
+
+	gate.configure({ 3, 1, 1 });
+
+	int batch_key = 0, normal_key = 0, queued_key = 0, request_key = 0;
+
+	BOOST_CHECK(gate.enter(priority_class::bulk));
+	gate.lease(&batch_key, priority_class::bulk);
+
+	BOOST_CHECK(gate.enter(priority_class::normal));
+	gate.lease(&normal_key, priority_class::normal);
+
+	std::vector<priority_class> order{};
+
+	gate.async_enter(priority_class::bulk,
+					 [&](bool value)
+					 {
+						 BOOST_CHECK(value);
+
+						 gate.lease(&queued_key, priority_class::bulk);
+
+						 order.push_back(priority_class::bulk);
+					 });
+
+	BOOST_CHECK_EQUAL(gate.waiting(priority_class::bulk), 1);
+
+	gate.async_enter(priority_class::interactive,
+					 [&](bool value)
+					 {
+						 BOOST_CHECK(value);
+
+						 gate.lease(&request_key, priority_class::interactive);
+
+						 order.push_back(priority_class::interactive);
+					 });
+
+	BOOST_CHECK_EQUAL(gate.in_use(priority_class::interactive), 1);
+
+	BOOST_CHECK(gate.leave(&normal_key));
+	gate.notify();
+
+	BOOST_CHECK_EQUAL(gate.waiting(priority_class::bulk), 1);
+
+	BOOST_CHECK(gate.leave(&batch_key));
+	gate.notify();
+
+	BOOST_CHECK_EQUAL(gate.waiting(priority_class::bulk), 0);
+	BOOST_CHECK(order == std::vector<priority_class>({ priority_class::interactive, priority_class::bulk }));
+
+	std::thread request(
+		[&]
+		{
+			gate.enter(priority_class::normal);
+
+			gate.lease(&normal_key, priority_class::normal);
+		});
+
+	while (gate.waiting(priority_class::normal) == 0)
+	{
+		std::this_thread::yield();
+	}
+
+	BOOST_CHECK(gate.leave(&request_key));
+	gate.notify();
+
+	request.join();
+
+	BOOST_CHECK_EQUAL(gate.in_use(priority_class::normal), 1);
+	BOOST_CHECK(!gate.leave(&request_key));
+
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<capture_service> pool(io_pool, "127.0.0.1", boost::mysql::default_port_string, "kcwl",
+												 "123456", "test_mysql");
+
+	BOOST_CHECK(!pool.enable_priority({ pool.capacity() + 1 }));
+	BOOST_CHECK(!pool.priorities().enabled());
+	BOOST_CHECK(pool.enable_priority());
+	BOOST_CHECK(pool.priorities().enabled());
+
+	pool.stop();
+}
+
+BOOST_AUTO_TEST_CASE(concurrency_limit)
+{
+	auto ec = aquarius::make_error_code(aquarius::pool_errc::overloaded);
+
+	BOOST_CHECK_EQUAL(std::string(ec.category().name()), "aquarius.pool");
+	BOOST_CHECK_EQUAL(ec.message(), "too many operations in flight");
+
+	aquarius::concurrency_options options{};
+
+	options.initial_limit = 4;
+
+	aquarius::concurrency_limiter limiter(options);
+
+	auto fill = [&]
+	{
+		while (limiter.try_acquire())
+		{
+		}
+	};
+
+	fill();
+
+	BOOST_CHECK_EQUAL(limiter.inflight(), 4);
+	BOOST_CHECK_EQUAL(limiter.rejected(), 1);
+
+	for (int i = 0; i < 20; ++i)
+	{
+		limiter.release(1000);
+
+		fill();
+	}
+
+	auto grown = limiter.limit();
+
+	BOOST_CHECK(grown > 4);
+	BOOST_CHECK_EQUAL(limiter.inflight(), grown);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		limiter.release(20000);
+
+		fill();
+	}
+
+	BOOST_CHECK(limiter.limit() < grown);
+	BOOST_CHECK(limiter.limit() >= options.min_limit);
+
+	options.probe_interval = 50;
+
+	aquarius::concurrency_limiter brownout(options);
+
+	std::size_t highest = 0;
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		while (brownout.try_acquire())
+		{
+		}
+
+		auto queued = std::max<std::size_t>(brownout.inflight(), 8);
+
+		brownout.release(1000 * queued / 8);
+
+		if (i > 1000)
+			highest = std::max(highest, brownout.limit());
+	}
+
+	BOOST_CHECK(highest < 32);
+
+	aquarius::io_service_pool io_pool{ 1 };
+
+	aquarius::service_pool<aquarius::mysql_connect> pool(io_pool, "127.0.0.1", boost::mysql::default_port_string,
+														 "kcwl", "123456", "test_mysql");
+
+	options.initial_limit = 0;
+
+	pool.enable_concurrency_limit(options);
+
+	boost::mysql::error_code rejected{};
+
+	BOOST_CHECK(!pool.execute("select 1", rejected));
+	BOOST_CHECK(rejected == ec);
+
+	rejected = {};
+
+	pool.async_execute("select 1",
+					   [&](bool value, const boost::mysql::error_code& error)
+					   {
+						   BOOST_CHECK(!value);
+
+						   rejected = error;
+					   });
+
+	BOOST_CHECK(rejected == ec);
+}
+
+class recording_tracer : public aquarius::tracer
+{
+	class span : public aquarius::trace_span
+	{
+	public:
+		span(recording_tracer& owner, std::string_view name, aquarius::trace_span* parent)
+			: owner_(owner)
+			, text_(name)
+		{
+			text_ += "<";
+			text_ += parent ? static_cast<span*>(parent)->name_ : std::string{};
+			text_ += ">";
+
+			name_ = std::string(name);
+		}
+
+	public:
+		void set_attribute(std::string_view key, std::string_view value) override
+		{
+			text_.append(" ").append(key).append("=").append(value);
+		}
+
+		void set_attribute(std::string_view key, std::int64_t value) override
+		{
+			set_attribute(key, std::to_string(value));
+		}
+
+		void set_error(std::string_view message) override
+		{
+			set_attribute("error", message);
+		}
+
+		void end() override
+		{
+			owner_.ended.push_back(text_);
+		}
+
+	private:
+		recording_tracer& owner_;
+
+		std::string name_;
+
+		std::string text_;
+	};
+
+public:
+	std::unique_ptr<aquarius::trace_span> start_span(std::string_view name, aquarius::trace_span* parent,
+													 std::chrono::system_clock::time_point) override
+	{
+		return std::make_unique<span>(*this, name, parent);
+	}
+
+public:
+	std::vector<std::string> ended;
+};
+
+BOOST_AUTO_TEST_CASE(tracing)
+{
+	BOOST_CHECK(!aquarius::scoped_span(aquarius::span_name::query));
+
+	auto tracer = std::make_shared<recording_tracer>();
+
+	aquarius::tracing::set_tracer(tracer);
+
+	{
+		aquarius::scoped_span query(aquarius::span_name::query);
+
+		{
+			aquarius::scoped_span acquire(aquarius::span_name::acquire);
+
+			acquire.set_attribute("db.rows", 3);
+		}
+
+		{
+			std::optional<aquarius::scoped_span> build(std::in_place, aquarius::span_name::build);
+
+			aquarius::scoped_span moved(std::move(*build));
+
+			build.reset();
+
+			BOOST_CHECK(aquarius::scoped_span::current() == moved.get());
+		}
+
+		BOOST_CHECK(aquarius::scoped_span::current() == query.get());
+	}
+
+	aquarius::tracing::set_tracer(nullptr);
+
+	BOOST_CHECK(aquarius::scoped_span::current() == nullptr);
+	BOOST_CHECK_EQUAL(tracer->ended.size(), 3);
+	BOOST_CHECK_EQUAL(tracer->ended[0], "mysql.acquire<mysql.query> db.rows=3");
+	BOOST_CHECK_EQUAL(tracer->ended[1], "mysql.build<mysql.query>");
+	BOOST_CHECK_EQUAL(tracer->ended[2], "mysql.query<>");
+
+	std::weak_ptr<aquarius::tracer> owner = tracer;
+
+	tracer.reset();
+
+	aquarius::tracing::set_tracer(nullptr);
+
+	BOOST_CHECK(owner.expired());
+}
+
+BOOST_AUTO_TEST_CASE(stand_in)
+{
+	aquarius::io_service_pool io_pool{ 2 };
+
+	aquarius::stand_in_server server(io_pool.get_io_service());
+
+	server.add_table(aquarius::generate_table("products",
+											  { { "prod_id", aquarius::stand_in_type::integer },
+												{ "prod_name", aquarius::stand_in_type::text },
+												{ "prod_price", aquarius::stand_in_type::integer },
+												{ "vend_id", aquarius::stand_in_type::integer } },
+											  100));
+
+	server.start();
+
+	aquarius::service_pool<aquarius::mysql_connect> pool(io_pool, "127.0.0.1", std::to_string(server.port()),
+														 "stand_in", "stand_in", "stand_in");
+
+	std::thread t([&] { io_pool.run(); });
+
+	BOOST_CHECK(pool.wait_ready());
+
+	auto result = aquarius::select<products>(pool);
+
+	BOOST_CHECK_EQUAL(result.size(), 100);
+	BOOST_CHECK_EQUAL(result.front().prod_name, "prod_name_0");
+	BOOST_CHECK_EQUAL(aquarius::count<products>(pool), 100);
+
+	auto view = pool.query_view<reflect_products>("select * from products");
+
+	BOOST_REQUIRE_EQUAL(view.size(), 100);
+
+	auto row = view[1];
+
+	auto iter = view.begin();
+
+	view = {};
+
+	BOOST_CHECK_EQUAL(row.get<"prod_name">(), "prod_name_1");
+	BOOST_CHECK_EQUAL(row.to_struct().prod_id, 1);
+	BOOST_CHECK_EQUAL((*iter++).get<0>(), 0);
+	BOOST_CHECK_EQUAL((*iter).get<"prod_name">(), "prod_name_1");
+
+	std::vector<std::string> names{};
+
+	BOOST_CHECK(pool.query_rows("select prod_name from products where prod_id between 3 and 5 order by prod_id limit 2",
+								[&](const auto& row, const auto&)
+								{
+									BOOST_CHECK_EQUAL(row.size(), 1);
+
+									names.emplace_back(row.at(0).as_string());
+								}));
+
+	BOOST_CHECK(names == std::vector<std::string>({ "prod_name_3", "prod_name_4" }));
+
+	auto picked =
+		aquarius::select_chain(pool).select<products>().prepare_where(AQUARIUS_EXPR(prod_id) == 3).query<products>();
+
+	BOOST_REQUIRE_EQUAL(picked.size(), 1);
+	BOOST_CHECK_EQUAL(picked.front().prod_name, "prod_name_3");
+
+	BOOST_CHECK(aquarius::chain_sql(pool).prepare_insert(products{ 102, "o'neil", 4, 3 }).execute());
+
+	std::promise<bool> replaced{};
+
+	aquarius::chain_sql(pool)
+		.prepare_replace(products{ 102, "o'neil", 5, 3 })
+		.async_execute([&](bool value) { replaced.set_value(value); });
+
+	BOOST_CHECK(replaced.get_future().get());
+
+	BOOST_CHECK(!pool.query_rows("select nope from products", [](const auto&, const auto&) {}));
+	BOOST_CHECK(!pool.query_rows("select * from products where prod_name like 'x%'", [](const auto&, const auto&) {}));
+	BOOST_CHECK(!pool.query_rows("select * from products group by vend_id", [](const auto&, const auto&) {}));
+
+	BOOST_CHECK(aquarius::insert(pool, products{ 101, "candy", 3, 1 }));
+	BOOST_CHECK(server.connections() >= 1);
+
+	pool.stop();
+
+	server.stop();
+
+	io_pool.stop();
+
+	t.join();
+}
+
+BOOST_AUTO_TEST_CASE(stand_in_recovery)
+{
+	aquarius::io_service_pool io_pool{ 2 };
+
+	aquarius::stand_in_options options{};
+
+	options.truncate_rate = 0.2;
+	options.disconnect_rate = 0.05;
+
+	aquarius::stand_in_server server(io_pool.get_io_service(), options);
+
+	server.add_table(aquarius::generate_table("products",
+											  { { "prod_id", aquarius::stand_in_type::integer },
+												{ "prod_name", aquarius::stand_in_type::text },
+												{ "prod_price", aquarius::stand_in_type::integer },
+												{ "vend_id", aquarius::stand_in_type::integer } },
+											  100));
+
+	server.start();
+
+	aquarius::service_pool<aquarius::mysql_connect> pool(io_pool, "127.0.0.1", std::to_string(server.port()),
+														 "stand_in", "stand_in", "stand_in");
+
+	std::thread t([&] { io_pool.run(); });
+
+	pool.wait_ready();
+
+	std::size_t failures = 0;
+
+	for (int i = 0; i < 60; ++i)
+	{
+		std::size_t rows = 0;
+
+		if (!pool.query_rows("select * from products", [&](const auto&, const auto&) { ++rows; }))
+		{
+			++failures;
+
+			continue;
+		}
+
+		BOOST_CHECK_EQUAL(rows, 100);
+	}
+
+	BOOST_CHECK(failures > 0);
+	BOOST_CHECK(failures < 40);
+
+	pool.stop();
+
+	server.stop();
+
+	io_pool.stop();
+
+	t.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,344 @@
+#pragma once
+#include "mysql_server.h"
+#include <aquarius/mysql.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <semaphore>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(mysql_workload)
+
+struct sbtest
+{
+	int id;
+	int k;
+	std::string c;
+	std::string pad;
+};
+
+enum class workload_profile
+{
+	point_select,
+	range_scan,
+	read_write,
+	insert_heavy
+};
+
+inline std::string_view workload_name(workload_profile profile)
+{
+	switch (profile)
+	{
+	case workload_profile::point_select:
+		return "point_select";
+	case workload_profile::range_scan:
+		return "range_scan";
+	case workload_profile::read_write:
+		return "read_write";
+	case workload_profile::insert_heavy:
+		return "insert_heavy";
+	}
+
+	return "unknown";
+}
+
+struct workload_options
+{
+	workload_profile profile = workload_profile::point_select;
+
+	std::size_t clients = 8;
+
+	std::size_t concurrency = 4;
+
+	std::chrono::milliseconds duration{ 1000 };
+
+	std::size_t table_size = 1000;
+
+	std::size_t range_size = 100;
+
+	std::size_t point_selects = 10;
+
+	std::size_t insert_ratio = 10;
+
+	std::uint64_t seed = 1;
+};
+
+struct workload_report
+{
+	workload_options options;
+
+	std::uint64_t elapsed_ns = 0;
+
+	std::uint64_t transactions = 0;
+
+	std::uint64_t queries = 0;
+
+	std::uint64_t errors = 0;
+
+	std::uint64_t rows = 0;
+
+	std::size_t pool_size = 0;
+
+	std::uint64_t connections_created = 0;
+
+	aquarius::histogram_snapshot latency;
+};
+
+inline void workload_print(const workload_report& report)
+{
+	auto seconds = static_cast<double>(report.elapsed_ns) / 1e9;
+
+	std::cout << "{\"workload\":\"" << workload_name(report.options.profile)
+			  << "\",\"clients\":" << report.options.clients << ",\"concurrency\":" << report.options.concurrency
+			  << ",\"pool_size\":" << report.pool_size
+			  << ",\"seconds\":" << seconds << ",\"transactions\":" << report.transactions
+			  << ",\"queries\":" << report.queries << ",\"errors\":" << report.errors << ",\"rows\":" << report.rows
+			  << ",\"tps\":" << (seconds > 0 ? report.transactions / seconds : 0)
+			  << ",\"qps\":" << (seconds > 0 ? report.queries / seconds : 0) << ",\"p50_ns\":" << report.latency.p50
+			  << ",\"p90_ns\":" << report.latency.p90 << ",\"p99_ns\":" << report.latency.p99
+			  << ",\"p999_ns\":" << report.latency.p999 << ",\"max_ns\":" << report.latency.max
+			  << ",\"connections_created\":" << report.connections_created << "}" << std::endl;
+}
+
+class workload_driver
+{
+public:
+	workload_driver(mysql_pool& pool, workload_options options)
+		: pool_(pool)
+		, options_(options)
+		, gate_(static_cast<std::ptrdiff_t>(std::min(options.concurrency, pool.capacity())))
+	{
+		options_.concurrency = std::min(options.concurrency, pool.capacity());
+	}
+
+public:
+	void prepare()
+	{
+		pool_.execute("create table if not exists sbtest(id int not null primary key, k int not null default 0, "
+					  "c char(120) not null default '', pad char(60) not null default '')");
+
+		if (aquarius::count<sbtest>(pool_) >= options_.table_size)
+			return;
+
+		std::mt19937_64 engine(options_.seed);
+
+		for (std::size_t id = 1; id <= options_.table_size; ++id)
+		{
+			aquarius::replace(pool_, make_row(static_cast<int>(id), engine));
+		}
+	}
+
+	workload_report run()
+	{
+		pool_.metrics().reset();
+
+		latency_.reset();
+
+		std::atomic<std::uint64_t> transactions{ 0 };
+
+		std::vector<std::thread> clients{};
+
+		auto start = std::chrono::steady_clock::now();
+
+		auto deadline = start + options_.duration;
+
+		for (std::size_t i = 0; i < options_.clients; ++i)
+		{
+			clients.emplace_back(
+				[&, i]
+				{
+					std::mt19937_64 engine(options_.seed + i);
+
+					while (std::chrono::steady_clock::now() < deadline)
+					{
+						auto begin = std::chrono::steady_clock::now();
+
+						gate_.acquire();
+
+						transaction(engine, i);
+
+						gate_.release();
+
+						latency_.record(aquarius::elapsed_ns(begin));
+
+						transactions.fetch_add(1, std::memory_order_relaxed);
+					}
+				});
+		}
+
+		for (auto& client : clients)
+		{
+			client.join();
+		}
+
+		auto snapshot = pool_.snapshot();
+
+		workload_report report{};
+
+		report.options = options_;
+		report.elapsed_ns = aquarius::elapsed_ns(start);
+		report.transactions = transactions.load(std::memory_order_relaxed);
+		report.queries = snapshot.queries;
+		report.errors = snapshot.errors;
+		report.rows = snapshot.rows;
+		report.pool_size = pool_.capacity();
+		report.connections_created = snapshot.connections_created;
+		report.latency = latency_.snapshot({});
+
+		return report;
+	}
+
+private:
+	void transaction(std::mt19937_64& engine, std::size_t client)
+	{
+		switch (options_.profile)
+		{
+		case workload_profile::point_select:
+			point_select(engine);
+			break;
+		case workload_profile::range_scan:
+			range_scan(engine);
+			break;
+		case workload_profile::read_write:
+		{
+			for (std::size_t i = 0; i < options_.point_selects; ++i)
+			{
+				point_select(engine);
+			}
+
+			range_scan(engine);
+
+			auto id = random_id(engine);
+
+			aquarius::update_if(pool_, make_row(id, engine), AQUARIUS_EXPR(id) == id);
+
+			id = owned_id(engine, client);
+
+			aquarius::remove_if<sbtest>(pool_, AQUARIUS_EXPR(id) == id);
+
+			aquarius::insert(pool_, make_row(id, engine));
+		}
+		break;
+		case workload_profile::insert_heavy:
+		{
+			auto id = static_cast<int>(options_.table_size + next_id_.fetch_add(1, std::memory_order_relaxed) + 1);
+
+			aquarius::insert(pool_, make_row(id, engine));
+
+			if (options_.insert_ratio != 0 && engine() % options_.insert_ratio == 0)
+				point_select(engine);
+		}
+		break;
+		}
+	}
+
+	void point_select(std::mt19937_64& engine)
+	{
+		aquarius::select_if<sbtest>(pool_, AQUARIUS_EXPR(id) == random_id(engine));
+	}
+
+	void range_scan(std::mt19937_64& engine)
+	{
+		auto low = random_id(engine);
+
+		aquarius::select_if<sbtest>(pool_,
+									AQUARIUS_EXPR(id).between(low, low + static_cast<int>(options_.range_size) - 1));
+	}
+
+	int random_id(std::mt19937_64& engine) const
+	{
+		return static_cast<int>(engine() % options_.table_size) + 1;
+	}
+
+	int owned_id(std::mt19937_64& engine, std::size_t client) const
+	{
+		auto span = std::max<std::size_t>(options_.table_size / options_.clients, 1);
+
+		return static_cast<int>(engine() % span * options_.clients + client) + 1;
+	}
+
+	static sbtest make_row(int id, std::mt19937_64& engine)
+	{
+		sbtest row{ id, static_cast<int>(engine() % 100000), std::string(119, '0'), std::string(59, '0') };
+
+		for (auto& c : row.c)
+		{
+			c = static_cast<char>('0' + engine() % 10);
+		}
+
+		for (auto& c : row.pad)
+		{
+			c = static_cast<char>('0' + engine() % 10);
+		}
+
+		return row;
+	}
+
+private:
+	mysql_pool& pool_;
+
+	workload_options options_;
+
+	std::counting_semaphore<> gate_;
+
+	std::atomic<std::uint64_t> next_id_{ 0 };
+
+	aquarius::latency_histogram latency_;
+};
+
+BOOST_AUTO_TEST_CASE(oltp_profiles)
+{
+	aquarius::io_service_pool io_pool{ 2 };
+
+	aquarius::stand_in_server server(io_pool.get_io_service(), { std::chrono::microseconds(50) });
+
+	workload_options options{};
+
+	server.add_table(aquarius::generate_table("sbtest",
+											  { { "id", aquarius::stand_in_type::integer },
+												{ "k", aquarius::stand_in_type::integer },
+												{ "c", aquarius::stand_in_type::text },
+												{ "pad", aquarius::stand_in_type::text } },
+											  options.table_size));
+
+	server.start();
+
+	mysql_pool pool(io_pool, "127.0.0.1", std::to_string(server.port()), "sbtest", "sbtest", "sbtest");
+
+	std::thread t([&] { io_pool.run(); });
+
+	BOOST_CHECK(pool.wait_ready());
+
+	for (auto profile : { workload_profile::point_select, workload_profile::range_scan, workload_profile::read_write,
+						  workload_profile::insert_heavy })
+	{
+		options.profile = profile;
+
+		workload_driver driver(pool, options);
+
+		auto report = driver.run();
+
+		workload_print(report);
+
+		BOOST_CHECK(report.transactions > 0);
+		BOOST_CHECK(report.queries >= report.transactions);
+		BOOST_CHECK_EQUAL(report.errors, 0);
+		BOOST_CHECK(report.options.concurrency <= report.pool_size);
+	}
+
+	pool.stop();
+
+	server.stop();
+
+	io_pool.stop();
+
+	t.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,37 @@
+#!/bin/sh
+# Times the front end on reflection of 32, 64 and 128 field structs.
+# usage: CXX=g++ CXXFLAGS="-I<aquarius include> -I<boost include>" test/reflect_compile_time.sh
+
+CXX=${CXX:-c++}
+
+dir=$(mktemp -d)
+
+trap 'rm -rf "$dir"' EXIT
+
+for width in 32 64 128; do
+	src="$dir/reflect_$width.cpp"
+
+	{
+		echo "#include <aquarius/mysql/reflect.hpp>"
+		echo "#include <cstdint>"
+		echo "struct wide {"
+
+		i=0
+		while [ $i -lt $width ]; do
+			echo "	int64_t c$i;"
+			i=$((i + 1))
+		done
+
+		echo "};"
+		echo "static_assert(aquarius::tuple_size_v<wide> == $width);"
+		echo "int64_t sum(const wide& value) { return aquarius::get<$((width - 1))>(aquarius::tie_fields(value)); }"
+	} > "$src"
+
+	start=$(date +%s%N)
+
+	$CXX -std=c++20 $CXXFLAGS -fsyntax-only "$src" || exit 1
+
+	end=$(date +%s%N)
+
+	echo "{\"benchmark\":\"compile_reflect_$width\",\"ms\":$(((end - start) / 1000000))}"
+done